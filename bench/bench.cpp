@@ -0,0 +1,448 @@
+// LED Matrix Clock render/input micro-benchmarks (make bench)
+// Runs every hot path of the clock on its own and reports ns/op and heap
+// allocations/op, on stdout and as JSON (for tracking regressions between
+// releases and comparing the Pi's Cortex-A53 with x86 dev boxes). Built
+// like make headless: no LED matrix library, no root.
+
+#include "version.h"
+#include "Config.h"
+#include "Animator.h"
+#include "BorderSnakeAnimation.h"
+#include "BitmapFont.h"
+#include "TextMeasurer.h"
+#include "LayoutEngine.h"
+#include "FrameBuffer.h"
+#include "Scene.h"
+#include "Compositor.h"
+#include "HeadlessDisplay.h"
+#include "TimeFormat.h"
+#include "LocalTime.h"
+#include "MonotonicClock.h"
+#include "GPIOBackend.h"
+#include "GPIOButton.h"
+#include "json.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/utsname.h>
+
+#define BENCH_MIN_NS 200000000LL            // Minimum measured time per benchmark (ns)
+#define BENCH_MAX_ITERATIONS 100000000UL    // Iteration cap per benchmark
+#define BENCH_TIME 1735689598               // Base instant of the time benchmarks (2024-12-31 23:59:58 UTC)
+
+using json = nlohmann::json;
+
+// Heap allocations since start (operator new is replaced below; not
+// inlined, so callers never see malloc/free paired with new/delete)
+static unsigned long g_allocations = 0;
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    g_allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+// Keeps benchmark results alive
+static volatile unsigned long g_sink = 0;
+
+// One benchmark result
+struct BenchResult {
+    std::string name;               // Benchmark name
+    double ns_per_op;               // Mean time per operation (ns)
+    double allocs_per_op;           // Heap allocations per operation
+    unsigned long iterations;       // Operations measured
+    std::string skipped;            // Reason the benchmark could not run (empty = ran)
+};
+
+static std::vector<BenchResult> g_results;
+
+// Run op(i) in growing batches until a batch takes BENCH_MIN_NS, record the last batch
+template <typename Op>
+static void bench(const std::string& name, Op op) {
+    unsigned long iterations = 1;
+    for (;;) {
+        unsigned long allocations = g_allocations;
+        int64_t start = monotonicNs();
+        for (unsigned long i = 0; i < iterations; i++) op(i);
+        int64_t elapsed = monotonicNs() - start;
+        allocations = g_allocations - allocations;
+
+        if (elapsed >= BENCH_MIN_NS || iterations >= BENCH_MAX_ITERATIONS) {
+            BenchResult result = { name, static_cast<double>(elapsed) / iterations,
+                                   static_cast<double>(allocations) / iterations, iterations, "" };
+            g_results.push_back(result);
+            printf("  %-56s %12.1f ns/op %8.2f allocs/op\n", name.c_str(), result.ns_per_op, result.allocs_per_op);
+            fflush(stdout);
+            return;
+        }
+
+        // Aim 20% past the minimum, growing 2x to 100x per batch
+        double scale = elapsed > 0 ? 1.2 * BENCH_MIN_NS / elapsed : 100.0;
+        if (scale < 2.0) scale = 2.0;
+        if (scale > 100.0) scale = 100.0;
+        iterations = static_cast<unsigned long>(iterations * scale);
+        if (iterations > BENCH_MAX_ITERATIONS) iterations = BENCH_MAX_ITERATIONS;
+    }
+}
+
+// Record a benchmark that cannot run on this machine
+static void skip(const std::string& name, const std::string& reason) {
+    BenchResult result = { name, 0.0, 0.0, 0, reason };
+    g_results.push_back(result);
+    printf("  %-56s skipped (%s)\n", name.c_str(), reason.c_str());
+}
+
+// Load a bundled font (FONT_DIR), exit on failure
+static void loadFont(BitmapFont& font, const char* name) {
+    std::string path = std::string(FONT_DIR) + name;
+    if (!font.load(path.c_str())) {
+        fprintf(stderr, "Couldn't load font: %s\n", path.c_str());
+        exit(1);
+    }
+}
+
+// Broken-down time of BENCH_TIME + seconds, without a time zone lookup
+static void benchTime(unsigned long seconds, struct tm& tm) {
+    time_t t = BENCH_TIME + static_cast<time_t>(seconds % 86400);
+    gmtime_r(&t, &tm);
+}
+
+// Color transitions
+static void benchAnimation() {
+    printf("Animation\n");
+
+    Animator animator;
+    animator.startTransition(RGBColor(255, 0, 0), RGBColor(0, 0, 255), 3600000);
+    bench("Animator::update", [&](unsigned long) {
+        g_sink += animator.update().r;
+    });
+    bench("Animator::rotateHue", [&](unsigned long i) {
+        g_sink += Animator::rotateHue(RGBColor(255, 128, 0), static_cast<int>(i % 360)).g;
+    });
+
+    BorderSnakeAnimation snake(64, 32, 16);
+    snake.start(RGBColor(255, 0, 0), RGBColor(0, 0, 255), 3600000);
+    bench("BorderSnakeAnimation::update", [&](unsigned long) {
+        g_sink += snake.update().size();
+    });
+}
+
+// Date/time formatting and local time conversion
+static void benchTime() {
+    printf("Date/time\n");
+
+    char date[64], time_text[64];
+    bench("strftime date+time (uppercased)", [&](unsigned long i) {
+        struct tm tm;
+        benchTime(i, tm);
+        strftime(date, sizeof(date), "%a %d %b", &tm);
+        for (char* p = date; *p; p++) *p = static_cast<char>(toupper(static_cast<unsigned char>(*p)));
+        strftime(time_text, sizeof(time_text), "%H:%M:%S", &tm);
+        g_sink += date[0] + time_text[7];
+    });
+
+    TimeFormat date_format("%a %d %b", true);
+    TimeFormat time_format("%H:%M:%S");
+    bench("TimeFormat::update date+time", [&](unsigned long i) {
+        struct tm tm;
+        benchTime(i, tm);
+        date_format.update(tm);
+        time_format.update(tm);
+        g_sink += date_format.text()[0] + time_format.text()[7];
+    });
+
+    bench("localtime_r", [&](unsigned long i) {
+        time_t t = BENCH_TIME + static_cast<time_t>(i);
+        struct tm tm;
+        localtime_r(&t, &tm);
+        g_sink += tm.tm_sec;
+    });
+    LocalTime local_time;
+    bench("LocalTime::at", [&](unsigned long i) {
+        g_sink += local_time.at(BENCH_TIME + static_cast<time_t>(i)).tm_sec;
+    });
+}
+
+// Text measurement and the layout branches of the clock screen
+static void benchLayout(const BitmapFont& font_date, const BitmapFont& font_time) {
+    printf("Text and layout\n");
+
+    TextMeasurer measurer;
+    bench("TextMeasurer::width (cached)", [&](unsigned long i) {
+        g_sink += measurer.width(font_time, i & 1 ? "23:59:58" : "00:00:01");
+    });
+    bench("TextMeasurer::width (cold)", [&](unsigned long i) {
+        measurer.clear();
+        g_sink += measurer.width(font_time, i & 1 ? "23:59:58" : "00:00:01");
+    });
+
+    // Clock branches: relayout (new date each op) and a time tick (same width)
+    struct Branch {
+        const char* name;
+        bool show_date, show_time;
+        const char* wrap;
+        const char* date[2];
+    };
+    static const Branch branches[] = {
+        { "date+time",          true,  true,  "greedy",   { "TUE 31 DEC", "WED 01 JAN" } },
+        { "date only, greedy",  true,  false, "greedy",   { "TUESDAY 31 DECEMBER 2024", "WEDNESDAY 01 JANUARY 2025" } },
+        { "date only, balanced", true, false, "balanced", { "TUESDAY 31 DECEMBER 2024", "WEDNESDAY 01 JANUARY 2025" } },
+        { "time only",          false, true,  "greedy",   { "TUE 31 DEC", "WED 01 JAN" } },
+    };
+    for (size_t b = 0; b < sizeof(branches) / sizeof(branches[0]); b++) {
+        const Branch& branch = branches[b];
+        Config config;
+        config.showDate = branch.show_date;
+        config.showTime = branch.show_time;
+        config.dateWrap = branch.wrap;
+        LayoutEngine layout_engine(config, font_date, font_time, measurer, 64, 32);
+
+        bench(std::string("LayoutEngine::clock relayout [") + branch.name + "]", [&](unsigned long i) {
+            g_sink += layout_engine.clock(branch.date[i & 1], i & 1 ? "00:00:01" : "23:59:58").runs.size();
+        });
+        bench(std::string("LayoutEngine::clock tick [") + branch.name + "]", [&](unsigned long i) {
+            g_sink += layout_engine.clock(branch.date[0], i & 1 ? "12:34:56" : "12:34:57").runs.size();
+        });
+    }
+
+    Config config;
+    LayoutEngine layout_engine(config, font_date, font_time, measurer, 64, 32);
+    bench("LayoutEngine::centered (message)", [&](unsigned long i) {
+        g_sink += layout_engine.centered(font_time, i & 1 ? "100%" : "ROSSO", 20).runs.size();
+    });
+}
+
+// Glyph drawing: per-pixel writes (the old DrawText path) vs span fills
+static void benchText() {
+    printf("Text drawing\n");
+
+    static const char* const fonts[] = { "logisoso46.bdf", "spleen-32x64.bdf", "7x14B.bdf" };
+    for (size_t f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        BitmapFont font;
+        loadFont(font, fonts[f]);
+        FrameBuffer framebuffer(64, 32);
+        const RGBColor color(255, 128, 0);
+        const char* text = "12:34";
+        int y = font.baseline() < 32 ? font.baseline() : 31;
+
+        bench(std::string("per-pixel setPixel [") + fonts[f] + "]", [&](unsigned long) {
+            int pen = 0;
+            for (const char* p = text; *p; p++) {
+                const Glyph* g = font.glyph(static_cast<unsigned char>(*p));
+                if (!g) continue;
+                const GlyphSpan* span = font.spans() + g->first_span;
+                for (uint32_t s = 0; s < g->span_count; s++, span++) {
+                    for (int k = 0; k < span->length; k++) framebuffer.setPixel(pen + span->x + k, y + span->y, color);
+                }
+                pen += g->advance;
+            }
+            g_sink += framebuffer.pixels()[0];
+        });
+        bench(std::string("FrameBuffer::drawText spans [") + fonts[f] + "]", [&](unsigned long) {
+            g_sink += framebuffer.drawText(font, 0, y, color, text);
+        });
+    }
+}
+
+// Frame pipeline: scene recomposition, overlay blending, canvas transfer
+static void benchPipeline(const BitmapFont& font_date, const BitmapFont& font_time) {
+    printf("Frame pipeline\n");
+
+    TextMeasurer measurer;
+    Config config;
+    LayoutEngine layout_engine(config, font_date, font_time, measurer, 64, 32);
+    Scene scene(64, 32);
+    LayoutNode* node = new LayoutNode();
+    scene.root().add(node);
+    FrameBuffer scene_buffer(64, 32);
+    bench("Scene::compose (time tick)", [&](unsigned long i) {
+        char time_text[16];
+        snprintf(time_text, sizeof(time_text), "12:34:%02lu", i % 60);
+        node->set(layout_engine.clock("TUE 31 DEC", time_text), RGBColor(255, 128, 0), layout_engine.timeRun());
+        scene.compose(scene_buffer);
+        g_sink += scene_buffer.pixels()[0];
+    });
+
+    for (int scale = 1; scale <= 2; scale++) {
+        int width = 64 * scale, height = 32 * scale;
+        std::vector<uint8_t> rgb(width * height * 3, 40);
+        std::vector<uint8_t> rgba(width * height * 4);
+        for (size_t i = 0; i < rgba.size(); i++) rgba[i] = static_cast<uint8_t>(i * 7);
+        char name[64];
+        snprintf(name, sizeof(name), "Compositor::blendRow [%dx%d]", width, height);
+        bench(name, [&](unsigned long) {
+            Compositor::blendRow(&rgb[0], &rgba[0], width * height, 128);
+            g_sink += rgb[0];
+        });
+    }
+
+    Compositor compositor(64, 32);
+    int message_layer = compositor.addLayer();
+    int snake_layer = compositor.addLayer();
+    compositor.clear(message_layer, RGBColor(), 255);
+    compositor.drawText(message_layer, font_time, 10, 20, RGBColor(255, 255, 255), "ROSSO");
+    for (int x = 0; x < 16; x++) compositor.setPixel(snake_layer, x, 0, RGBColor(0, 0, 255));
+    FrameBuffer framebuffer(64, 32);
+    bench("Compositor::composite [64x32, 2 layers]", [&](unsigned long i) {
+        compositor.setOpacity(message_layer, static_cast<uint8_t>(i));
+        compositor.composite(scene_buffer.pixels(), framebuffer);
+        g_sink += framebuffer.pixels()[0];
+    });
+
+    HeadlessDisplay display(64, 32, 100);
+    bench("FrameBuffer::transfer (time tick)", [&](unsigned long i) {
+        framebuffer.fillRect(40, 16, 14, 14, RGBColor(i & 1 ? 255 : 0, 0, 0));
+        framebuffer.transfer(display.offscreen());
+        display.swap();
+        g_sink += display.pixels()[0];
+    });
+}
+
+// Configuration file
+static void benchConfig() {
+    printf("Config\n");
+
+    char path[] = "/tmp/led-clock-bench-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        skip("Config::save", "mkstemp failed");
+        skip("Config::load", "mkstemp failed");
+        return;
+    }
+    close(fd);
+
+    Config config;
+    bench("Config::save", [&](unsigned long) {
+        g_sink += config.save(path);
+    });
+    bench("Config::load", [&](unsigned long) {
+        g_sink += config.load(path);
+    });
+    unlink(path);
+}
+
+// Button sampling with every backend available on this machine
+static void benchInput() {
+    printf("Input\n");
+
+    // File-backed stand-in for the GPIO register page
+    char page[] = "/tmp/led-clock-bench-gpio-XXXXXX";
+    int fd = mkstemp(page);
+    if (fd >= 0) {
+        std::vector<char> zero(4096, 0);
+        if (write(fd, &zero[0], zero.size()) != static_cast<ssize_t>(zero.size())) perror("write");
+        close(fd);
+    }
+
+    // Endless-looking script: one tap per minute
+    char script[] = "/tmp/led-clock-bench-sim-XXXXXX";
+    fd = mkstemp(script);
+    if (fd >= 0) {
+        std::string edges;
+        for (int i = 0; i < 1000; i++) {
+            char line[64];
+            snprintf(line, sizeof(line), "%d press\n%d release\n", i * 60000, i * 60000 + 100);
+            edges += line;
+        }
+        if (write(fd, edges.data(), edges.size()) != static_cast<ssize_t>(edges.size())) perror("write");
+        close(fd);
+    }
+
+    std::vector<std::string> specs;
+    specs.push_back("gpiochip");
+    specs.push_back("gpiomem");
+    specs.push_back(std::string("gpiomem:") + page);
+    specs.push_back("pinctrl");
+    specs.push_back(std::string("sim:") + script);
+    for (size_t s = 0; s < specs.size(); s++) {
+        // Short names: the temporary paths change on every run
+        std::string label = specs[s].compare(0, 8, "gpiomem:") == 0 ? "gpiomem:file"
+                          : specs[s].compare(0, 4, "sim:") == 0 ? "sim" : specs[s];
+        std::string name = "GPIOButton::poll [" + label + "]";
+
+        GPIOButton button(createGPIOBackend(specs[s], GPIO_NUM));
+        button.onShortPress([]() { g_sink++; });
+        if (!button.setup()) {
+            skip(name, "backend unavailable");
+            continue;
+        }
+        std::string kind = specs[s].substr(0, specs[s].find(':'));
+        if (kind != button.backend()->name()) name += std::string(" (fell back to ") + button.backend()->name() + ")";
+        bench(name, [&](unsigned long i) {
+            button.poll(static_cast<long>(i));
+        });
+    }
+
+    unlink(page);
+    unlink(script);
+}
+
+// Write the results as JSON
+static bool writeJson(const char* path) {
+    struct utsname host;
+    uname(&host);
+
+    json j;
+    j["version"] = VERSION_STRING;
+    j["machine"] = host.machine;
+    j["host"] = host.nodename;
+    j["kernel"] = host.release;
+    j["compiler"] = __VERSION__;
+    j["timestamp"] = static_cast<long long>(time(nullptr));
+    j["results"] = json::array();
+    for (size_t i = 0; i < g_results.size(); i++) {
+        const BenchResult& r = g_results[i];
+        json entry;
+        entry["name"] = r.name;
+        if (r.skipped.empty()) {
+            entry["ns_per_op"] = r.ns_per_op;
+            entry["allocs_per_op"] = r.allocs_per_op;
+            entry["iterations"] = r.iterations;
+        } else {
+            entry["skipped"] = r.skipped;
+        }
+        j["results"].push_back(entry);
+    }
+
+    std::ofstream out(path);
+    out << j.dump(2) << std::endl;
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char** argv) {
+    const char* json_path = argc > 1 ? argv[1] : "bench.json";
+
+    printf("LED Matrix Clock v%s benchmarks\n", VERSION_STRING);
+
+    BitmapFont font_date, font_time;
+    loadFont(font_date, "5x8.bdf");
+    loadFont(font_time, "7x14B.bdf");
+
+    benchAnimation();
+    benchTime();
+    benchLayout(font_date, font_time);
+    benchText();
+    benchPipeline(font_date, font_time);
+    benchConfig();
+    benchInput();
+
+    if (!writeJson(json_path)) {
+        fprintf(stderr, "Failed to write %s\n", json_path);
+        return 1;
+    }
+    printf("Results written to %s\n", json_path);
+    return 0;
+}
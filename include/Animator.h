@@ -60,6 +60,14 @@ public:
      */
     void cancel();
 
+    /**
+     * Rotate the hue of a color, keeping saturation and value
+     * @param color Source color
+     * @param degrees Hue offset in degrees (any sign, wraps at 360)
+     * @return Color with rotated hue
+     */
+    static RGBColor rotateHue(const RGBColor& color, int degrees);
+
 private:
     /**
      * Cubic ease-in-out easing function
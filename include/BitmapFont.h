@@ -0,0 +1,99 @@
+#ifndef BITMAP_FONT_H
+#define BITMAP_FONT_H
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+/** Code point drawn in place of glyphs missing from a font */
+#define REPLACEMENT_CODEPOINT 0xFFFD
+
+/**
+ * Horizontal run of lit pixels in a glyph
+ */
+struct GlyphSpan {
+    int16_t x;       // First column, relative to the pen position
+    int16_t y;       // Row, relative to the baseline (negative = above)
+    int16_t length;  // Number of lit pixels
+};
+
+/**
+ * Pre-decoded glyph
+ */
+struct Glyph {
+    int advance;             // Horizontal advance (DWIDTH)
+    uint32_t first_span;     // Index of the first span in BitmapFont::spans()
+    uint32_t span_count;     // Number of spans
+};
+
+/**
+ * BDF Bitmap Font with Pre-decoded Glyph Spans
+ * Parses a BDF font once and stores every glyph as a list of horizontal
+ * runs of lit pixels, so drawing a glyph is a handful of row fills instead
+ * of testing every bit of its bitmap. Metrics follow rpi-rgb-led-matrix's
+ * Font (height and baseline from FONTBOUNDINGBOX, pixels clipped to the
+ * glyph's advance), so text lands on the same pixels as DrawText().
+ */
+class BitmapFont {
+public:
+    /**
+     * Constructor - empty font
+     */
+    BitmapFont();
+
+    /**
+     * Load and decode a BDF font
+     * @param path Path to the .bdf file
+     * @return true if the font was loaded, false otherwise
+     */
+    bool load(const char* path);
+
+    /**
+     * Font height (FONTBOUNDINGBOX height)
+     * @return Height in pixels
+     */
+    int height() const;
+
+    /**
+     * Baseline offset from the top of the font box
+     * @return Baseline in pixels
+     */
+    int baseline() const;
+
+    /**
+     * Advance width of a code point
+     * @param codepoint Unicode code point
+     * @return Advance in pixels, or -1 if the font has no such glyph
+     */
+    int characterWidth(uint32_t codepoint) const;
+
+    /**
+     * Glyph of a code point, falling back to U+FFFD
+     * @param codepoint Unicode code point
+     * @return Glyph, or nullptr if neither glyph exists
+     */
+    const Glyph* glyph(uint32_t codepoint) const;
+
+    /**
+     * Span storage shared by all glyphs
+     * @return Pointer to the first span
+     */
+    const GlyphSpan* spans() const;
+
+private:
+    /**
+     * Look up a glyph without fallback
+     * @param codepoint Unicode code point
+     * @return Glyph, or nullptr if missing
+     */
+    const Glyph* find(uint32_t codepoint) const;
+
+    int height_;                           // Font height
+    int baseline_;                         // Baseline from the top
+    std::vector<Glyph> glyphs_;            // All glyphs
+    std::vector<GlyphSpan> spans_;         // Spans of all glyphs
+    int ascii_[128];                       // Glyph index of ASCII code points (-1 = missing)
+    std::map<uint32_t, int> other_;        // Glyph index of other code points
+};
+
+#endif // BITMAP_FONT_H
@@ -5,20 +5,33 @@
 #include <vector>
 
 // Hardware and system configuration
-#define GPIO_NUM 19                         // GPIO pin number for button input
-#define CONFIG_PATH "/root/clock-config.json"  // Path to configuration file
+#define GPIO_NUM 19                         // Default GPIO pin for the "main" button (see "buttons" in config)
+#define GPIO_CHIP "/dev/gpiochip0"          // GPIO character device owning the button pins
+#ifndef CONFIG_PATH
+#define CONFIG_PATH "/root/clock-config.json"  // Path to configuration file (make headless overrides it)
+#endif
+#ifndef FONT_DIR
+#define FONT_DIR "/root/fonts/"             // Directory of the BDF fonts (make headless overrides it)
+#endif
+#ifndef STATS_SOCKET_PATH
+#define STATS_SOCKET_PATH "/run/led-clock/stats.sock"  // Frame-stage statistics socket (make headless overrides it)
+#endif
 
 // Display timing constants
 #define COLOR_DISPLAY_MS 2000               // Duration to show color/brightness messages (ms)
 #define VERSION_DISPLAY_MS 4000             // Duration to show version/IP at startup (ms)
+#define MESSAGE_FADE_MS 200                 // Fade-in/out time of color/brightness messages (ms)
 
 // Brightness control constants
 #define MIN_BRIGHTNESS 20                   // Minimum brightness level (%)
 #define MAX_BRIGHTNESS 100                  // Maximum brightness level (%)
 #define BRIGHTNESS_INC_STEP 10              // Brightness increment step (%)
 
+// Rotary encoder constants
+#define ENCODER_SAVE_DELAY_MS 1000          // Save config once the encoder has been idle this long (ms)
+
 // Main loop timing
-#define MAIN_LOOP_USLEEP 30000              // Main loop sleep duration (microseconds, 40ms = 25 FPS)
+#define FRAME_INTERVAL_MS 30                // Frame interval while animating or polling input (ms, ~33 FPS)
 
 /**
  * Named color structure for display colors
@@ -28,6 +41,14 @@ struct NamedColor {
     uint8_t r, g, b;   // RGB color components (0-255)
 };
 
+/**
+ * Input button definition
+ */
+struct ButtonConfig {
+    std::string name;  // Button role (e.g., "main", "mode", "up", "down", "snooze")
+    int pin;           // GPIO pin number (line offset on GPIO_CHIP)
+};
+
 /**
  * Configuration class for LED Matrix Clock
  * Manages loading, saving, and validating all clock settings
@@ -43,6 +64,7 @@ public:
     bool colorTransitionEnabled;            // Enable automatic color transitions in AUTO mode
     int colorTransitionIntervalMinutes;     // Minutes between automatic color changes
     int colorTransitionDurationMs;          // Duration of color transition animation (ms)
+    int hueShift;                           // Hue rotation applied to the display color (degrees, 0-359)
 
     // Time and date formatting
     std::string dateFormat;                 // strftime format string for date (e.g., "%a %d %b")
@@ -58,6 +80,23 @@ public:
     bool dateIgnoreDescenders;              // Ignore descenders for date (true for uppercase-only text)
     bool timeIgnoreDescenders;              // Ignore descenders for time (true for uppercase-only text)
     int dateTimeSpacing;                    // Vertical spacing between date and time in pixels
+    std::string dateWrap;                   // Wrap of a too-wide date-only display: "greedy" or "balanced"
+
+    // Input settings
+    std::string buttonBackend;              // Button backend spec ("gpiochip[:path]", "gpiomem[:path]", "pinctrl", "sim:<script>")
+    std::vector<ButtonConfig> buttons;      // Input buttons (all requested in one gpiochip line request)
+    int gestureDebounceMs;                  // Presses shorter than this are ignored (ms)
+    int gestureLongPressMs;                 // Hold time for a long press (ms)
+    int gestureMultiTapMs;                  // Max gap between taps of a double/triple tap (ms, 0 = off)
+    int gestureRepeatIntervalMs;            // Auto-repeat period while held after a long press (ms, 0 = off)
+
+    // Rotary encoder settings
+    bool encoderEnabled;                    // Enable the quadrature rotary encoder
+    int encoderPinA;                        // GPIO pin of encoder channel A
+    int encoderPinB;                        // GPIO pin of encoder channel B
+    int encoderStepsPerDetent;              // Quadrature transitions per detent (usually 4)
+    std::string encoderFunction;            // What rotation adjusts: "brightness" or "hue"
+    int encoderStep;                        // Adjustment per detent (% brightness or degrees of hue)
 
     /**
      * Constructor - initializes configuration with default values
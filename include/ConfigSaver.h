@@ -0,0 +1,64 @@
+#ifndef CONFIG_SAVER_H
+#define CONFIG_SAVER_H
+
+#include "Config.h"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Background Config Writer
+ * Writes snapshots of the configuration to disk on its own thread, so a
+ * slow SD card never holds up the logic thread or the frames it publishes.
+ * Only the newest snapshot matters: a request made while a write is in
+ * progress replaces any snapshot still waiting, and is written next.
+ */
+class ConfigSaver {
+public:
+    /**
+     * Constructor - saves synchronously until start()
+     * @param path Config file written by every save
+     */
+    explicit ConfigSaver(const std::string& path);
+
+    /**
+     * Destructor - writes the pending snapshot and stops the thread
+     */
+    ~ConfigSaver();
+
+    /**
+     * Start the writer thread
+     * @return true if running
+     */
+    bool start();
+
+    /**
+     * Write the pending snapshot, then stop and join the writer thread
+     * (no-op if not running)
+     */
+    void stop();
+
+    /**
+     * Queue a save of the current configuration (copied, never waits for a write)
+     * @param config Configuration to snapshot
+     */
+    void request(const Config& config);
+
+private:
+    /**
+     * Writer thread body: write the newest snapshot until stop()
+     */
+    void threadLoop();
+
+    std::string path_;              // Config file path
+    std::mutex lock_;               // Guards pending_, has_pending_ and stopping_
+    std::condition_variable wake_;  // A snapshot was queued (or stop)
+    Config pending_;                // Newest snapshot not yet written
+    bool has_pending_;              // pending_ holds a snapshot
+    bool stopping_;                 // Asks the thread to exit once pending_ is written
+    bool running_;                  // Writer thread started
+    std::thread thread_;            // Writer thread
+};
+
+#endif // CONFIG_SAVER_H
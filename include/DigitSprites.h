@@ -0,0 +1,90 @@
+#ifndef DIGIT_SPRITES_H
+#define DIGIT_SPRITES_H
+
+#include "Animator.h"
+#include "BitmapFont.h"
+#include <stdint.h>
+#include <vector>
+
+#define DIGIT_SPRITE_GLYPHS "0123456789:"   // Glyphs pre-rasterized for the time string
+#define DIGIT_SPRITE_COUNT 11               // Number of DIGIT_SPRITE_GLYPHS
+#define DIGIT_SPRITE_SLOTS 128              // Code points with a lookup slot (DIGIT_SPRITE_GLYPHS are ASCII)
+
+/**
+ * Per-Digit Sprite Cache
+ * The digits and ':' of the time font pre-rasterized in the current color
+ * into small RGB images: one glyph cell each (advance wide), black
+ * background, covering the rows where any of these glyphs has ink. A time
+ * digit is then drawn as a single row-copy blit (SpriteNode) instead of
+ * decoding its spans.
+ *
+ * Glyphs with ink outside their own cell are not cached (they would be cut
+ * off or overwrite a neighbor). The images are rebuilt only when the font
+ * or the color changes; image pointers stay valid until then.
+ */
+class DigitSprites {
+public:
+    /**
+     * Constructor - empty cache
+     */
+    DigitSprites();
+
+    /**
+     * Rasterize the glyphs for a font and color (if not current)
+     * @param font Time font
+     * @param color Text color
+     * @return true if the images were rebuilt (previous pointers are stale)
+     */
+    bool build(const BitmapFont& font, const RGBColor& color);
+
+    /**
+     * Image of a code point
+     * @param codepoint Unicode code point
+     * @return Packed RGB image (advance x height()), or nullptr if not cached
+     */
+    const uint8_t* image(uint32_t codepoint) const;
+
+    /**
+     * Cell width of a cached code point
+     * @param codepoint Unicode code point
+     * @return Advance in pixels (0 if not cached)
+     */
+    int advance(uint32_t codepoint) const;
+
+    /**
+     * Top row of the images relative to the baseline
+     * @return Offset (negative = above the baseline)
+     */
+    int top() const;
+
+    /**
+     * Height of the images
+     * @return Rows
+     */
+    int height() const;
+
+private:
+    /** One cached glyph */
+    struct Sprite {
+        int advance;                    // Cell width
+        size_t offset;                  // First byte of the image in pixels_
+    };
+
+    /**
+     * Cached sprite of a code point
+     * @param codepoint Unicode code point
+     * @return Sprite, or nullptr if not cached
+     */
+    const Sprite* find(uint32_t codepoint) const;
+
+    Sprite sprites_[DIGIT_SPRITE_COUNT]; // Cached glyphs
+    int count_;                          // Sprites in use
+    int8_t slots_[DIGIT_SPRITE_SLOTS];   // Sprite index of each ASCII code point (-1 = not cached)
+    std::vector<uint8_t> pixels_;        // All images, packed RGB
+    const BitmapFont* font_;             // Font the images were built from (nullptr = none)
+    RGBColor color_;                     // Color they were built in
+    int top_;                            // Top row relative to the baseline
+    int height_;                         // Image height
+};
+
+#endif // DIGIT_SPRITES_H
@@ -0,0 +1,115 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <stdint.h>
+
+/**
+ * Display Canvas Interface
+ * One buffer of a double-buffered display. Frames are transferred into the
+ * offscreen canvas pixel by pixel; brightness applies to pixels as they are
+ * written (like rgb_matrix::FrameCanvas), so a brightness change needs a
+ * full rewrite of each canvas.
+ */
+class DisplayCanvas {
+public:
+    /**
+     * Virtual destructor
+     */
+    virtual ~DisplayCanvas() {}
+
+    /**
+     * Set one pixel (clipped)
+     * @param x Column
+     * @param y Row
+     * @param r Red
+     * @param g Green
+     * @param b Blue
+     */
+    virtual void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) = 0;
+
+    /**
+     * Set the brightness applied to pixels written from now on
+     * @param percent Brightness (0-100)
+     */
+    virtual void setBrightness(uint8_t percent) = 0;
+
+    /**
+     * Brightness applied to written pixels
+     * @return Brightness (0-100)
+     */
+    virtual uint8_t brightness() const = 0;
+};
+
+/**
+ * Display Backend Interface
+ * Abstracts the panel the frames end up on, so the whole render pipeline
+ * (framebuffer, scene, compositor, render thread) runs either on the LED
+ * matrix or on an in-memory canvas on any Linux machine.
+ */
+class Display {
+public:
+    /**
+     * Virtual destructor - releases the display
+     */
+    virtual ~Display() {}
+
+    /**
+     * Open the display
+     * @return true if the display is ready
+     */
+    virtual bool setup() = 0;
+
+    /**
+     * Width of the display
+     * @return Width in pixels
+     */
+    virtual int width() const = 0;
+
+    /**
+     * Height of the display
+     * @return Height in pixels
+     */
+    virtual int height() const = 0;
+
+    /**
+     * Canvas the next frame is drawn into (not shown until swap())
+     * @return Offscreen canvas (owned by the display)
+     */
+    virtual DisplayCanvas* offscreen() = 0;
+
+    /**
+     * Show the offscreen canvas (at the next vertical sync, if any); the
+     * previously shown canvas becomes the offscreen one
+     */
+    virtual void swap() = 0;
+
+    /**
+     * Set the panel brightness
+     * @param percent Brightness (0-100)
+     */
+    virtual void setBrightness(uint8_t percent) = 0;
+
+    /**
+     * Blank the panel
+     */
+    virtual void clear() = 0;
+
+    /**
+     * Short display name for logs (e.g. "matrix")
+     * @return Display name
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * Create the display of this build
+ * The LED matrix, or the headless canvas when built with HEADLESS_DISPLAY
+ * (make headless), which does not link rpi-rgb-led-matrix.
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @param brightness Initial brightness (%)
+ * @return Newly allocated display (caller owns, setup() not called)
+ */
+Display* createDisplay(int width, int height, int brightness);
+
+#endif // DISPLAY_H
@@ -0,0 +1,185 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include "Animator.h"
+#include "BitmapFont.h"
+#include "Display.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Software RGB Framebuffer with Span Glyph Blitter
+ * A frame is composed here (packed RGB, row-major) and handed to the
+ * display canvas with transfer(). Text is drawn from a BitmapFont's
+ * pre-decoded spans: each span is one contiguous row fill, clipped once,
+ * instead of a bit test and a SetPixel call per pixel.
+ *
+ * The framebuffer persists between frames: callers may redraw only what
+ * changed. Writes are tracked as a dirty rectangle, and transfer() copies
+ * to each canvas only the area that changed since that canvas was last
+ * written (with SwapOnVSync the offscreen canvas is two frames old).
+ */
+class FrameBuffer {
+public:
+    /**
+     * Constructor - allocates a black frame
+     * @param width Width in pixels
+     * @param height Height in pixels
+     */
+    FrameBuffer(int width, int height);
+
+    /**
+     * Reset the drawn rows to black
+     */
+    void clear();
+
+    /**
+     * Restrict drawing to a rectangle (clear() is not restricted)
+     * @param x0 Left column
+     * @param y0 Top row
+     * @param x1 One past the right column
+     * @param y1 One past the bottom row
+     */
+    void setClip(int x0, int y0, int x1, int y1);
+
+    /**
+     * Allow drawing on the whole frame again
+     */
+    void resetClip();
+
+    /**
+     * Set one pixel (clipped)
+     * @param x Column
+     * @param y Row
+     * @param color Pixel color
+     */
+    void setPixel(int x, int y, const RGBColor& color);
+
+    /**
+     * Fill a horizontal run of pixels (clipped)
+     * @param x First column
+     * @param y Row
+     * @param length Number of pixels
+     * @param color Pixel color
+     */
+    void fillSpan(int x, int y, int length, const RGBColor& color);
+
+    /**
+     * Fill a rectangle (clipped)
+     * @param x Left column
+     * @param y Top row
+     * @param w Width
+     * @param h Height
+     * @param color Fill color
+     */
+    void fillRect(int x, int y, int w, int h, const RGBColor& color);
+
+    /**
+     * Copy a packed RGB image, black pixels included (clipped)
+     * @param x Left column
+     * @param y Top row
+     * @param w Image width
+     * @param h Image height
+     * @param rgb Packed RGB pixels, row-major
+     */
+    void blit(int x, int y, int w, int h, const uint8_t* rgb);
+
+    /**
+     * Replace the whole frame, marking only the pixels that differ
+     * @param rgb Packed RGB pixels, row-major (width x height)
+     */
+    void assign(const uint8_t* rgb);
+
+    /**
+     * Draw UTF-8 text with a bitmap font
+     * @param font Font
+     * @param x Pen position (left edge)
+     * @param y Baseline
+     * @param color Text color
+     * @param utf8_text NUL-terminated UTF-8 text
+     * @return Advance of the text in pixels (same as DrawText)
+     */
+    int drawText(const BitmapFont& font, int x, int y, const RGBColor& color, const char* utf8_text);
+
+    /**
+     * Draw one glyph with a bitmap font
+     * @param font Font
+     * @param x Pen position (left edge)
+     * @param y Baseline
+     * @param color Glyph color
+     * @param codepoint Unicode code point (U+FFFD if missing)
+     * @return Advance of the glyph in pixels
+     */
+    int drawGlyph(const BitmapFont& font, int x, int y, const RGBColor& color, uint32_t codepoint);
+
+    /**
+     * Bring a canvas up to date with the frame
+     * Writes every pixel the first time a canvas is seen, afterwards only
+     * the area changed since that canvas was last transferred to.
+     * @param canvas Destination canvas, e.g. the display's offscreen canvas
+     */
+    void transfer(DisplayCanvas* canvas);
+
+    /**
+     * Forget what the canvases hold (next transfer() writes every pixel)
+     */
+    void invalidate();
+
+    /**
+     * Width of the frame
+     * @return Width in pixels
+     */
+    int width() const;
+
+    /**
+     * Height of the frame
+     * @return Height in pixels
+     */
+    int height() const;
+
+    /**
+     * Packed RGB pixels (3 bytes per pixel, row-major)
+     * @return Pointer to the first pixel
+     */
+    const uint8_t* pixels() const;
+
+private:
+    /** Rectangle [x0, x1) x [y0, y1); empty when x0 >= x1 */
+    struct Rect {
+        int x0, y0, x1, y1;
+    };
+
+    /** Canvas and the area it is missing */
+    struct CanvasState {
+        const DisplayCanvas* canvas;       // Canvas written by transfer()
+        Rect stale;                        // Changed since its last transfer
+    };
+
+    /**
+     * Grow the dirty rectangle and the row extents
+     * @param x0 Left column
+     * @param y0 Top row
+     * @param x1 One past the right column
+     * @param y1 One past the bottom row
+     */
+    void touch(int x0, int y0, int x1, int y1);
+
+    /**
+     * Union of two rectangles
+     * @param a First rectangle
+     * @param b Second rectangle
+     * @return Smallest rectangle holding both
+     */
+    static Rect unite(const Rect& a, const Rect& b);
+
+    int width_;                         // Width in pixels
+    int height_;                        // Height in pixels
+    std::vector<uint8_t> pixels_;       // Packed RGB, row-major
+    std::vector<int16_t> row_min_;      // First drawn column per row (width_ = empty row)
+    std::vector<int16_t> row_max_;      // One past the last drawn column per row
+    Rect dirty_;                        // Changed since the last transfer()
+    Rect clip_;                         // Drawing is limited to this area
+    std::vector<CanvasState> canvases_; // Canvases in the swap rotation
+};
+
+#endif // FRAME_BUFFER_H
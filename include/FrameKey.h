@@ -0,0 +1,56 @@
+#ifndef FRAME_KEY_H
+#define FRAME_KEY_H
+
+#include <stdint.h>
+
+/**
+ * Frame Content Key
+ * Incremental 64-bit FNV-1a hash over everything that reaches the pixels of
+ * a frame (shown strings, color, brightness, animation state). Two frames
+ * with the same key are identical, so the render loop can skip clearing,
+ * drawing and swapping when the key matches the frame on screen.
+ */
+class FrameKey {
+public:
+    /**
+     * Constructor - starts an empty key
+     */
+    FrameKey();
+
+    /**
+     * Start a new key for the next frame
+     */
+    void reset();
+
+    /**
+     * Mix a NUL-terminated string into the key (terminator included, so
+     * adjacent strings cannot alias each other)
+     * @param text String to add
+     * @return This key, for chaining
+     */
+    FrameKey& add(const char* text);
+
+    /**
+     * Mix an integer value into the key
+     * @param value Value to add
+     * @return This key, for chaining
+     */
+    FrameKey& add(int64_t value);
+
+    /**
+     * Current key value
+     * @return 64-bit hash of everything added since reset()
+     */
+    uint64_t value() const;
+
+private:
+    /**
+     * Mix one byte into the hash
+     * @param byte Byte to add
+     */
+    void mix(uint8_t byte);
+
+    uint64_t hash_;  // FNV-1a state
+};
+
+#endif // FRAME_KEY_H
@@ -0,0 +1,106 @@
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include "SpscRing.h"
+#include <atomic>
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define RECORDER_SLOTS 64                   // Frames queued for the writer thread (power of two)
+
+/**
+ * Frame Recorder
+ * Streams composed frames (before panel brightness) to a file with their
+ * timestamps, for offline review and for diffing render output between
+ * builds. Format by extension:
+ * - ".y4m": YUV4MPEG2, 4:4:4 full-range BT.601; each frame header carries
+ *   its time as "FRAME Xt=<us>" (the F rate is nominal: only drawn frames
+ *   are written). Plays in ffplay/mpv.
+ * - anything else: concatenated binary PPMs (P6), each with a "# t=<us>"
+ *   comment; byte-exact RGB, e.g. ffmpeg -f image2pipe -c:v ppm -i file.
+ * Times are microseconds since open().
+ *
+ * record() only copies the frame into a preallocated slot and never blocks:
+ * encoding and file writes happen on a background thread. When the writer
+ * falls RECORDER_SLOTS frames behind, frames are dropped and counted.
+ */
+class FrameRecorder {
+public:
+    /**
+     * Constructor - not recording until open()
+     * @param width Frame width in pixels
+     * @param height Frame height in pixels
+     */
+    FrameRecorder(int width, int height);
+
+    /**
+     * Destructor - flushes and closes the recording
+     */
+    ~FrameRecorder();
+
+    /**
+     * Create the file, write its header and start the writer thread
+     * @param path Output file (".y4m" for Y4M, otherwise PPM)
+     * @return true if recording
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Write the queued frames, stop the writer thread and close the file
+     * (no-op if not recording)
+     */
+    void close();
+
+    /**
+     * Queue a frame (one producer thread at a time, never blocks)
+     * @param rgb Packed RGB pixels, row-major (width x height)
+     * @param time_us Monotonic time of the frame in microseconds
+     */
+    void record(const uint8_t* rgb, int64_t time_us);
+
+    /**
+     * Check if a recording is open
+     * @return true between a successful open() and close()
+     */
+    bool recording() const;
+
+private:
+    /** Queued frame */
+    struct Entry {
+        int slot;                   // Index into slots_
+        int64_t time_us;            // Time since open()
+    };
+
+    /**
+     * Writer thread body: encode queued frames until close()
+     */
+    void threadLoop();
+
+    /**
+     * Encode one frame and write it to the file
+     * @param rgb Packed RGB pixels
+     * @param time_us Time since open()
+     */
+    void write(const uint8_t* rgb, int64_t time_us);
+
+    int width_;                                     // Frame width
+    int height_;                                    // Frame height
+    bool y4m_;                                      // Y4M (true) or PPM stream
+    FILE* file_;                                    // Output (nullptr = not recording)
+    std::string path_;                              // Output path (for logs)
+    int64_t start_us_;                              // Monotonic time of open() (us)
+    std::vector<std::vector<uint8_t> > slots_;      // Frame copies, RECORDER_SLOTS of them
+    std::vector<uint8_t> planes_;                   // Y4M planes being written
+    SpscRing<Entry, RECORDER_SLOTS> queued_;        // Producer -> writer
+    SpscRing<int, RECORDER_SLOTS> free_;            // Writer -> producer (slots to reuse)
+    std::thread thread_;                            // Writer thread
+    std::atomic<bool> stopping_;                    // Asks the writer to drain and exit
+    int wake_fd_;                                   // eventfd: a frame was queued (or stop)
+    unsigned long written_;                         // Frames written (writer thread)
+    std::atomic<unsigned long> dropped_;            // Frames dropped because the queue was full
+};
+
+#endif // FRAME_RECORDER_H
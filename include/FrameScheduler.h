@@ -0,0 +1,117 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <signal.h>
+#include <stdint.h>
+
+/**
+ * Event-Driven Frame Scheduler
+ * Replaces the fixed main loop sleep with a single epoll wait on:
+ * - a CLOCK_REALTIME timerfd armed at the next wall-clock boundary that
+ *   changes visible content (second or minute, see TimeFormat::period()), so the
+ *   frame lands right after the boundary without sleep drift; it is also
+ *   cancelled (and wakes the loop) when the system clock is set
+ * - a CLOCK_MONOTONIC timerfd armed at the earliest requested deadline
+ *   (next animation frame, message expiry, pending save, ...)
+ * - an eventfd signalled by the input threads when decoded input is queued
+ * - a signalfd for the signals passed to setup()
+ *
+ * Deadlines are collected for one wait at a time: call wakeAt() and
+ * wakeOnWallBoundary() for everything the next frame depends on, then wait().
+ * With nothing pending and a static display the process sleeps until the
+ * next visible change.
+ */
+class FrameScheduler {
+public:
+    /** Wake reasons returned by wait() (bitmask) */
+    enum Wake {
+        WAKE_DEADLINE = 1,  // Monotonic deadline reached
+        WAKE_WALL = 2,      // Wall-clock boundary reached (or clock was set)
+        WAKE_INPUT = 4,     // Input thread queued events
+        WAKE_SIGNAL = 8     // A watched signal arrived (see takeSignal)
+    };
+
+    /**
+     * Constructor - no fds are opened until setup()
+     */
+    FrameScheduler();
+
+    /**
+     * Destructor - closes all fds (signals stay blocked)
+     */
+    ~FrameScheduler();
+
+    /**
+     * Block the given signals and create the epoll set
+     * Call before any thread is started so every thread inherits the mask.
+     * @param signals Signals delivered through the signalfd
+     * @return true on success; on failure the signals are left unblocked
+     *         and wait() falls back to a fixed sleep
+     */
+    bool setup(const sigset_t& signals);
+
+    /**
+     * eventfd the input threads write to when they queue events
+     * @return File descriptor, or -1 if not set up
+     */
+    int notifyFd() const;
+
+    /**
+     * Request a wakeup at a monotonic time (earliest request wins)
+     * @param time_ms Deadline in milliseconds (CLOCK_MONOTONIC)
+     */
+    void wakeAt(long time_ms);
+
+    /**
+     * Request a wakeup at the next wall-clock multiple of period_s
+     * @param period_s Boundary period in seconds (1 or 60; <= 0 = none)
+     */
+    void wakeOnWallBoundary(int period_s);
+
+    /**
+     * Block until a requested deadline, wall boundary, input or signal
+     * Clears the requests collected since the previous wait().
+     * @return Bitmask of Wake reasons
+     */
+    int wait();
+
+    /**
+     * Take a signal received by wait()
+     * @param signo Signal number
+     * @return true if the signal arrived since the last call
+     */
+    bool takeSignal(int signo);
+
+    /**
+     * How late the last wait() woke up after the timer that ended it
+     * @return Lateness in microseconds (-1 if no timer expired, or after the fallback sleep)
+     */
+    int64_t lateness() const;
+
+private:
+    /**
+     * Fallback when setup() failed: fixed sleep capped at the next deadline
+     * @return WAKE_DEADLINE
+     */
+    int sleepFallback();
+
+    /**
+     * Keep the largest lateness of the timers that expired in this wait
+     * @param late_us Time since a timer's expiry in microseconds
+     */
+    void updateLateness(int64_t late_us);
+
+    int epoll_fd_;          // epoll set over the fds below
+    int deadline_fd_;       // CLOCK_MONOTONIC timerfd (absolute)
+    int wall_fd_;           // CLOCK_REALTIME timerfd (absolute, cancel on set)
+    int notify_fd_;         // eventfd written by the input threads
+    int signal_fd_;         // signalfd for the watched signals
+    sigset_t signals_;      // Watched (blocked) signals
+    sigset_t received_;     // Signals received and not yet taken
+
+    long next_deadline_ms_; // Earliest monotonic deadline for the next wait (-1 = none)
+    int wall_period_s_;     // Wall boundary period for the next wait (0 = none)
+    int64_t lateness_us_;   // Wake lateness of the last wait (-1 = not a timer wake)
+};
+
+#endif // FRAME_SCHEDULER_H
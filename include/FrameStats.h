@@ -0,0 +1,61 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include "Histogram.h"
+#include <cstdio>
+#include <mutex>
+#include <stdint.h>
+
+/**
+ * Per-Stage Frame Timing
+ * One fixed-bucket histogram (microseconds) per stage of the frame loop:
+ *   logic thread  - input (button/encoder dispatch), update (clock state
+ *                   through publish), jitter (wake-up lateness after the
+ *                   scheduler's timer)
+ *   render thread - layout, draw (scene), overlay (message and snake
+ *                   layers, compositing), transfer (canvas), swap
+ *                   (SwapOnVSync), frame (whole render)
+ * Each stage has its own lock, held only to add one sample or to read the
+ * histogram, so the two threads never wait for each other and recording
+ * never allocates. report() may run on any thread (StatsServer).
+ */
+class FrameStats {
+public:
+    /** Timed stage */
+    enum Stage {
+        INPUT,
+        UPDATE,
+        JITTER,
+        LAYOUT,
+        DRAW,
+        OVERLAY,
+        TRANSFER,
+        SWAP,
+        FRAME,
+        STAGE_COUNT
+    };
+
+    /**
+     * Constructor - initializes empty histograms
+     */
+    FrameStats();
+
+    /**
+     * Add one sample to a stage
+     * @param stage Stage
+     * @param us Duration in microseconds
+     */
+    void record(Stage stage, int64_t us);
+
+    /**
+     * Print count, p50/p99 and max of every stage
+     * @param out Output stream
+     */
+    void report(FILE* out) const;
+
+private:
+    Histogram histograms_[STAGE_COUNT];     // Samples per stage
+    mutable std::mutex locks_[STAGE_COUNT]; // Guards each histogram
+};
+
+#endif // FRAME_STATS_H
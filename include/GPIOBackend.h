@@ -0,0 +1,88 @@
+#ifndef GPIO_BACKEND_H
+#define GPIO_BACKEND_H
+
+#include <string>
+
+/**
+ * Timestamped level change of a GPIO line
+ */
+struct GPIOEdge {
+    int value;      // New line value (0 = low/pressed, 1 = high/released)
+    long time_ms;   // Edge timestamp in milliseconds (CLOCK_MONOTONIC, or script time)
+};
+
+/**
+ * GPIO Input Backend Interface
+ * Abstracts how a single input line is configured and sampled, so the
+ * GPIOButton gesture state machine can run on real hardware (gpiochip,
+ * pinctrl) or on a scripted simulation without a Raspberry Pi.
+ */
+class GPIOBackend {
+public:
+    /**
+     * Virtual destructor - releases backend resources
+     */
+    virtual ~GPIOBackend() {}
+
+    /**
+     * Configure the line as input with pull-up
+     * @return true if setup successful, false otherwise
+     */
+    virtual bool setup() = 0;
+
+    /**
+     * Read current line value
+     * @return 0 (pressed), 1 (released), or -1 (error)
+     */
+    virtual int read() = 0;
+
+    /**
+     * Fetch the next pending edge, if the backend records edges
+     * @param edge Output for the edge
+     * @return true if an edge was returned, false if none is pending
+     */
+    virtual bool readEdge(GPIOEdge& edge) { (void)edge; return false; }
+
+    /**
+     * File descriptor that becomes readable when edges are pending
+     * @return fd usable with epoll, or -1 if the backend must be polled
+     */
+    virtual int eventFd() const { return -1; }
+
+    /**
+     * Backend to try when setup() fails (e.g. pinctrl for gpiochip)
+     * @return Newly allocated fallback backend (caller owns), or nullptr
+     */
+    virtual GPIOBackend* fallback() const { return nullptr; }
+
+    /**
+     * Short backend name for logs (e.g. "gpiochip")
+     * @return Backend name
+     */
+    virtual const char* name() const = 0;
+};
+
+/**
+ * Create a backend from a config spec string
+ * Supported specs:
+ * - "gpiochip" or "gpiochip:/dev/gpiochipN" - kernel GPIO character device
+ * - "gpiomem" or "gpiomem:/path/to/page"     - memory-mapped GPIO registers
+ * - "pinctrl"                               - pinctrl CLI (one process per read)
+ * - "sim:/path/to/script"                   - replay a press/release script
+ * Unknown specs fall back to "gpiochip" with a warning.
+ * @param spec Backend spec string
+ * @param pin GPIO pin number (line offset)
+ * @return Newly allocated backend (caller owns)
+ */
+GPIOBackend* createGPIOBackend(const std::string& spec, int pin);
+
+/**
+ * Check whether a spec selects the GPIO character device
+ * Unknown specs count as gpiochip, matching createGPIOBackend()
+ * @param spec Backend spec string
+ * @param chip_path Output for the character device path (when true)
+ * @return true for "gpiochip", "gpiochip:<path>" and unknown specs
+ */
+bool isGPIOChipSpec(const std::string& spec, std::string& chip_path);
+
+#endif // GPIO_BACKEND_H
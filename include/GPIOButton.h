@@ -1,66 +1,125 @@
 #ifndef GPIO_BUTTON_H
 #define GPIO_BUTTON_H
 
+#include "GPIOBackend.h"
+#include "GestureRecognizer.h"
+#include "SpscRing.h"
+#include <atomic>
 #include <functional>
+#include <memory>
 
 /**
  * GPIO Button Handler Class
+ * Feeds a GestureRecognizer from a pluggable GPIOBackend (gpiochip
+ * character device, gpiomem registers, pinctrl CLI or scripted simulation).
+ * Edges reported by the backend are processed with their own timestamps,
+ * so gestures are classified independently of the loop period.
+ *
+ * In queued mode (see InputManager), an input thread calls process() at
+ * edge/deadline time and decoded events reach the render loop through a
+ * lock-free SPSC ring; poll() then only drains the ring and invokes the
+ * callbacks on the caller's thread.
+ *
  * Provides debounced button input with multiple event types:
- * - Press: Triggered when button is first pressed down
- * - Release: Triggered when button is released
+ * - Press: Triggered once the button has been held for debounce_ms
+ * - Release: Triggered when a reported press is released
  * - Tap: Triggered on short press (released before long_press_ms)
+ * - Double/Triple Tap: Short presses in quick succession (multi_tap_ms)
  * - Long Press: Triggered when button held for long_press_ms duration
+ * - Hold Repeat: Repeated every repeat_interval_ms while held after a long press
+ * - Hold Release: Triggered when released after a long press
  */
 class GPIOButton {
 public:
     /**
      * Constructor
-     * @param pin GPIO pin number for button input
-     * @param debounce_ms Debounce time in milliseconds (default: 80ms)
-     * @param long_press_ms Long press threshold in milliseconds (default: 1000ms)
+     * @param backend Input backend for the button line (takes ownership)
+     * @param timing Gesture timing windows (default: 80ms debounce, 1000ms long press)
      */
-    GPIOButton(int pin, int debounce_ms = 80, int long_press_ms = 1000);
+    explicit GPIOButton(GPIOBackend* backend, const GestureTiming& timing = GestureTiming());
 
     /**
-     * Destructor
+     * Destructor - releases the backend
      */
     ~GPIOButton();
 
     /**
      * Setup GPIO pin with pull-up resistor
+     * If the backend fails, its fallback (e.g. pinctrl for gpiochip) is tried
      * @return true if setup successful, false otherwise
      */
     bool setup();
 
     /**
      * Poll button state - call this regularly in main loop
-     * @param current_time_ms Current time in milliseconds for timing calculations
+     * Polling mode: runs process() and invokes callbacks directly.
+     * Queued mode: drains decoded events and invokes callbacks; never blocks.
+     * @param current_time_ms Current time in milliseconds (CLOCK_MONOTONIC)
      */
     void poll(long current_time_ms);
 
+    /**
+     * Run pending backend edges (with their own timestamps), then the
+     * current level sampled at current_time_ms, through the recognizer
+     * @param current_time_ms Current time in milliseconds
+     */
+    void process(long current_time_ms);
+
+    /**
+     * Route events through the SPSC ring instead of calling callbacks
+     * Enable before the producer thread starts calling process()
+     * @param queued true for queued mode, false for direct callbacks
+     */
+    void setQueued(bool queued);
+
+    /**
+     * Time at which process() must run next to fire a pending gesture
+     * @return Deadline in milliseconds, or -1 if nothing is pending
+     */
+    long nextDeadline() const;
+
+    /**
+     * Check if decoded events are waiting in the queue (queued mode)
+     * @return true if poll() has events to dispatch
+     */
+    bool hasQueuedEvents() const;
+
     // Event callback setters
 
     /**
      * Set callback for button press event
-     * Called immediately when button is pressed down
+     * Called once the press outlasts debounce_ms (bounces never report)
      * @param callback Function to call on button press
      */
     void onPress(std::function<void()> callback);
 
     /**
      * Set callback for button release event
-     * Called when button is released (regardless of press duration)
+     * Called when a reported press is released (regardless of its duration)
      * @param callback Function to call on button release
      */
     void onRelease(std::function<void()> callback);
 
     /**
      * Set callback for tap event
-     * Called on short press (released before long_press_ms threshold)
+     * Called on short press (released before long_press_ms threshold).
+     * Delayed by multi_tap_ms only if a double/triple tap callback is set
      * @param callback Function to call on tap
      */
     void onTap(std::function<void()> callback);
 
+    /**
+     * Set callback for double tap event (enables multi-tap classification)
+     * @param callback Function to call on double tap
+     */
+    void onDoubleTap(std::function<void()> callback);
+
+    /**
+     * Set callback for triple tap event (enables multi-tap classification)
+     * @param callback Function to call on triple tap
+     */
+    void onTripleTap(std::function<void()> callback);
+
     /**
      * Set callback for long press event
      * Called when button held for long_press_ms duration
@@ -69,6 +128,19 @@ public:
      */
     void onLongPress(std::function<void()> callback);
 
+    /**
+     * Set callback for hold auto-repeat (needs repeat_interval_ms > 0)
+     * Called every repeat_interval_ms while held after the long press
+     * @param callback Function to call on each repeat
+     */
+    void onHoldRepeat(std::function<void()> callback);
+
+    /**
+     * Set callback for release after a long press
+     * @param callback Function to call on hold release
+     */
+    void onHoldRelease(std::function<void()> callback);
+
     /**
      * Set callback for short press event (legacy compatibility)
      * Alias for onTap() - provided for backward compatibility
@@ -76,29 +148,43 @@ public:
      */
     void onShortPress(std::function<void()> callback);
 
+    /**
+     * Set an observer called right before any registered callback runs
+     * Used for latency instrumentation; runs on the dispatching thread
+     * @param observer Function receiving the event being dispatched
+     */
+    void onDispatch(std::function<void(const ButtonEvent&)> observer);
+
+    /**
+     * Get the active input backend
+     * @return Backend (owned by the button)
+     */
+    GPIOBackend* backend() const { return backend_.get(); }
+
 private:
     // Configuration
-    int pin_;                   // GPIO pin number
-    int debounce_ms_;           // Debounce time in milliseconds
-    int long_press_ms_;         // Long press threshold in milliseconds
+    std::unique_ptr<GPIOBackend> backend_;  // Line input backend
+    GestureRecognizer recognizer_;          // Timestamp-based gesture classifier
+
+    // Queued mode
+    std::atomic<bool> queued_;              // True while an input thread owns the recognizer
+    SpscRing<ButtonEvent, 32> events_;      // Decoded events: input thread -> render loop
 
-    // State tracking
-    int last_value_;            // Last GPIO pin value (0 or 1)
-    long button_press_start_;   // Timestamp when button was pressed
-    bool button_was_pressed_;   // Flag indicating button is currently pressed
-    bool long_press_triggered_; // Flag indicating long press was already triggered
+    // Event callbacks, indexed by ButtonEvent::Type
+    std::function<void()> callbacks_[ButtonEvent::HOLD_RELEASE + 1];
+    std::function<void(const ButtonEvent&)> dispatch_observer_; // Called before each callback
 
-    // Event callbacks
-    std::function<void()> press_callback_;      // Called on button press
-    std::function<void()> release_callback_;    // Called on button release
-    std::function<void()> tap_callback_;        // Called on short press/tap
-    std::function<void()> long_press_callback_; // Called on long press
+    /**
+     * Deliver an event: queue it in threaded mode, call the callback otherwise
+     * @param event Recognized gesture
+     */
+    void emit(const ButtonEvent& event);
 
     /**
-     * Read current GPIO pin value
-     * @return 0 (pressed), 1 (released), or -1 (error)
+     * Invoke the callback registered for an event's type
+     * @param event Event to dispatch
      */
-    int read();
+    void invoke(const ButtonEvent& event);
 };
 
 #endif // GPIO_BUTTON_H
@@ -0,0 +1,47 @@
+#ifndef GPIO_CHIP_BACKEND_H
+#define GPIO_CHIP_BACKEND_H
+
+#include "GPIOBackend.h"
+#include <linux/gpio.h>
+#include <string>
+
+/**
+ * GPIO Character Device Backend
+ * Requests the line once from /dev/gpiochipN with pull-up and both-edge
+ * detection. The level is read with a single GPIO_V2_LINE_GET_VALUES ioctl
+ * on the kept-open line fd; edge events carry kernel CLOCK_MONOTONIC
+ * timestamps. Works with the gpio-sim kernel module for testing.
+ */
+class GPIOChipBackend : public GPIOBackend {
+public:
+    /**
+     * Constructor
+     * @param pin Line offset on the chip
+     * @param chip_path GPIO character device path (default: GPIO_CHIP)
+     */
+    GPIOChipBackend(int pin, const std::string& chip_path);
+
+    /**
+     * Destructor - releases the line request
+     */
+    ~GPIOChipBackend();
+
+    bool setup();
+    int read();
+    bool readEdge(GPIOEdge& edge);
+    int eventFd() const;
+    GPIOBackend* fallback() const;
+    const char* name() const { return "gpiochip"; }
+
+private:
+    int pin_;                               // Line offset
+    std::string chip_path_;                 // Character device path
+    int line_fd_;                           // Line request fd (-1 = not requested)
+
+    // Edge events read in batches from the line fd
+    struct gpio_v2_line_event events_[16];  // Batch buffer
+    size_t event_count_;                    // Events in the buffer
+    size_t event_next_;                     // Next event to return
+};
+
+#endif // GPIO_CHIP_BACKEND_H
@@ -0,0 +1,87 @@
+#ifndef GPIO_CHIP_GROUP_H
+#define GPIO_CHIP_GROUP_H
+
+#include "GPIOBackend.h"
+#include "SpscRing.h"
+#include <linux/gpio.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * Batched GPIO Character Device Line Group
+ * Requests every input line in a single gpiochip line request (pull-up,
+ * both-edge detection) and samples all of them with one
+ * GPIO_V2_LINE_GET_VALUES ioctl per refresh(). Edge events are read in
+ * batches and demultiplexed by line offset, so the cost per frame stays
+ * constant as buttons are added.
+ *
+ * Each line is exposed as a GPIOBackend view (line()) that reads from the
+ * values and edges cached by the last refresh().
+ */
+class GPIOChipGroup {
+public:
+    /**
+     * Constructor
+     * @param chip_path GPIO character device path
+     * @param pins Line offsets to request (at most GPIO_V2_LINES_MAX)
+     */
+    GPIOChipGroup(const std::string& chip_path, const std::vector<int>& pins);
+
+    /**
+     * Destructor - releases the line request
+     */
+    ~GPIOChipGroup();
+
+    /**
+     * Request all lines in one line request
+     * @return true if the request succeeded
+     */
+    bool setup();
+
+    /**
+     * Drain pending edge events and read all line values (one ioctl)
+     * @return true if the values were read successfully
+     */
+    bool refresh();
+
+    /**
+     * Line request fd, readable when edge events are pending
+     * @return fd usable with epoll, or -1 before setup()
+     */
+    int fd() const { return line_fd_; }
+
+    /**
+     * Backend view of one line, fed by refresh() (caller owns)
+     * @param index Index into the pin list given to the constructor
+     * @return Newly allocated backend view
+     */
+    GPIOBackend* line(size_t index);
+
+private:
+    /**
+     * Per-line GPIOBackend view on the shared request
+     */
+    class Line : public GPIOBackend {
+    public:
+        Line(GPIOChipGroup* group, size_t index) : group_(group), index_(index) {}
+        bool setup() { return group_->line_fd_ >= 0; }
+        int read();
+        bool readEdge(GPIOEdge& edge);
+        GPIOBackend* fallback() const;
+        const char* name() const { return "gpiochip"; }
+
+    private:
+        GPIOChipGroup* group_;  // Shared line request
+        size_t index_;          // Line index in the request
+    };
+
+    std::string chip_path_;                         // Character device path
+    std::vector<int> pins_;                         // Requested line offsets
+    int line_fd_;                                   // Line request fd (-1 = not requested)
+    uint64_t values_;                               // Line values from the last refresh (bit i = line i)
+    bool values_valid_;                             // False if the last GET_VALUES failed
+    std::vector<SpscRing<GPIOEdge, 16> > edges_;    // Pending edges per line
+};
+
+#endif // GPIO_CHIP_GROUP_H
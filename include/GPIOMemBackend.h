@@ -0,0 +1,62 @@
+#ifndef GPIO_MEM_BACKEND_H
+#define GPIO_MEM_BACKEND_H
+
+#include "GPIOBackend.h"
+#include <stdint.h>
+#include <string>
+
+#define GPIOMEM_PATH "/dev/gpiomem"         // GPIO register block device (BCM283x/BCM2711)
+
+/**
+ * Memory-Mapped GPIO Register Backend
+ * Maps the GPIO register page through /dev/gpiomem (no root needed for
+ * members of the gpio group) and reads the pin with a single volatile load
+ * from GPLEV0/1. setup() selects input mode and enables the pull-up using
+ * the BCM2711 pull register or the legacy GPPUD/GPPUDCLK sequence.
+ *
+ * Any file of at least one page can stand in for /dev/gpiomem, so tests can
+ * drive the backend by writing level bits into a file-backed fake page.
+ * Not available on the Raspberry Pi 5 (RP1), which has no such page.
+ */
+class GPIOMemBackend : public GPIOBackend {
+public:
+    /**
+     * Constructor
+     * @param pin GPIO pin number (0-53)
+     * @param path Register page to map (default: GPIOMEM_PATH)
+     */
+    GPIOMemBackend(int pin, const std::string& path = GPIOMEM_PATH);
+
+    /**
+     * Destructor - unmaps the register page
+     */
+    ~GPIOMemBackend();
+
+    /**
+     * Map the registers, select input mode and enable the pull-up
+     * GPFSEL and the pull registers are shared with other pins (the LED
+     * matrix among them) and updated with a non-atomic read-modify-write,
+     * so call this before anything else configures GPIO pins, i.e. before
+     * the matrix is started
+     * @return true if setup successful, false otherwise
+     */
+    bool setup();
+    int read();
+    GPIOBackend* fallback() const;
+    const char* name() const { return "gpiomem"; }
+
+private:
+    /**
+     * Enable the pull-up resistor on the pin
+     * @param bcm2711 true for the BCM2711 pull register, false for GPPUD
+     */
+    void enablePullUp(bool bcm2711);
+
+    int pin_;                           // GPIO pin number
+    std::string path_;                  // Mapped device or fake register file
+    volatile uint32_t* regs_;           // Mapped GPIO register page (nullptr = unmapped)
+    volatile uint32_t* level_;          // GPLEV register holding pin_
+    uint32_t mask_;                     // Bit of pin_ in *level_
+};
+
+#endif // GPIO_MEM_BACKEND_H
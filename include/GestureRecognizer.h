@@ -0,0 +1,119 @@
+#ifndef GESTURE_RECOGNIZER_H
+#define GESTURE_RECOGNIZER_H
+
+#include <functional>
+
+/**
+ * Decoded button gesture event
+ * Produced by the input thread and consumed by the render loop
+ */
+struct ButtonEvent {
+    enum Type {
+        PRESS,          // Button went down (reported once held for debounce_ms, stamped with the press edge)
+        RELEASE,        // Button went up after a reported PRESS (bounces report neither)
+        TAP,            // Single short press
+        DOUBLE_TAP,     // Two short presses within the multi-tap window
+        TRIPLE_TAP,     // Three short presses within the multi-tap window
+        LONG_PRESS,     // Held for the long press threshold
+        HOLD_REPEAT,    // Auto-repeat while still held after a long press
+        HOLD_RELEASE    // Released after a long press
+    };
+    Type type;      // Gesture type
+    long time_ms;   // When the gesture happened (edge or deadline time, not processing time)
+};
+
+/**
+ * Gesture timing windows (configurable in JSON under "gestures")
+ */
+struct GestureTiming {
+    int debounce_ms;            // Presses shorter than this are ignored as bounce
+    int long_press_ms;          // Hold time before LONG_PRESS
+    int multi_tap_ms;           // Max gap between taps of a double/triple tap (0 = disabled)
+    int repeat_interval_ms;     // HOLD_REPEAT period after LONG_PRESS (0 = disabled)
+
+    /** Default constructor - 80ms debounce, 1s long press, multi-tap and repeat off */
+    GestureTiming() : debounce_ms(80), long_press_ms(1000), multi_tap_ms(0), repeat_interval_ms(0) {}
+};
+
+/**
+ * Timestamp-Based Gesture Recognizer
+ * Classifies taps, double/triple taps, long presses, hold auto-repeat and
+ * hold-then-release purely from edge timestamps and the deadlines derived
+ * from them. Deadlines that expired before an edge are fired first, with
+ * their own timestamps, so the result is the same whether the caller runs
+ * at every edge, once per frame, or once per second.
+ */
+class GestureRecognizer {
+public:
+    /**
+     * Constructor
+     * @param timing Gesture timing windows
+     */
+    explicit GestureRecognizer(const GestureTiming& timing = GestureTiming());
+
+    /**
+     * Set the function receiving recognized gestures
+     * @param sink Called for every gesture, in time order
+     */
+    void setSink(std::function<void(const ButtonEvent&)> sink);
+
+    /**
+     * Enable waiting for double/triple taps
+     * When disabled, TAP is reported on release without multi-tap delay
+     * @param enabled true to classify multi-taps (needs timing.multi_tap_ms > 0)
+     */
+    void setMultiTapEnabled(bool enabled);
+
+    /**
+     * Feed a line level change (duplicates of the current level are ignored)
+     * @param value Line value (0 = pressed, 1 = released)
+     * @param time_ms Edge timestamp in milliseconds
+     */
+    void edge(int value, long time_ms);
+
+    /**
+     * Fire every deadline up to now (long press, repeat, multi-tap expiry)
+     * @param now_ms Current time in milliseconds
+     */
+    void tick(long now_ms);
+
+    /**
+     * Earliest pending deadline
+     * @return Deadline in milliseconds, or -1 if nothing is pending
+     */
+    long nextDeadline() const;
+
+private:
+    /**
+     * Fire deadlines that expired at or before a given time
+     * @param until_ms Time up to which deadlines are due
+     */
+    void fireDeadlines(long until_ms);
+
+    /**
+     * Report the pending taps as TAP/DOUBLE_TAP/TRIPLE_TAP and clear them
+     * @param time_ms Gesture timestamp
+     */
+    void flushTaps(long time_ms);
+
+    /**
+     * Deliver one gesture to the sink
+     */
+    void emit(ButtonEvent::Type type, long time_ms);
+
+    GestureTiming timing_;                          // Timing windows
+    bool multi_tap_enabled_;                        // Wait for double/triple taps
+    std::function<void(const ButtonEvent&)> sink_;  // Gesture receiver
+
+    // State
+    int level_;             // Current line level (1 = released)
+    bool pressed_;          // Button is down
+    bool press_reported_;   // PRESS already reported for this press (held past debounce)
+    long press_start_;      // Timestamp of the last press edge
+    bool long_fired_;       // LONG_PRESS already reported for this press
+    long next_repeat_;      // Next HOLD_REPEAT deadline
+    int tap_count_;         // Taps waiting for the multi-tap window to close
+    long tap_deadline_;     // Multi-tap window end (-1 while pressed or idle)
+};
+
+#endif // GESTURE_RECOGNIZER_H
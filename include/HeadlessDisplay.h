@@ -0,0 +1,77 @@
+#ifndef HEADLESS_DISPLAY_H
+#define HEADLESS_DISPLAY_H
+
+#include "Display.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Headless In-Memory Display
+ * Two RGB888 canvases in memory instead of the LED matrix: no GPIO, no
+ * refresh thread, no root. swap() exchanges them at once (there is no
+ * vertical sync to wait for), so the render pipeline can be profiled with
+ * perf or valgrind on a workstation and frames can be read back.
+ */
+class HeadlessDisplay : public Display {
+public:
+    /**
+     * Constructor - two black canvases
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param brightness Initial brightness (%)
+     */
+    HeadlessDisplay(int width, int height, int brightness);
+
+    bool setup();
+    int width() const;
+    int height() const;
+    DisplayCanvas* offscreen();
+    void swap();
+    void setBrightness(uint8_t percent);
+    void clear();
+    const char* name() const { return "headless"; }
+
+    /**
+     * Pixels of the shown canvas as written (before brightness)
+     * @return Packed RGB, row-major (width x height)
+     */
+    const uint8_t* pixels() const;
+
+    /**
+     * Panel brightness
+     * @return Brightness (%)
+     */
+    uint8_t brightness() const;
+
+    /**
+     * Number of swap() calls
+     * @return Frame count
+     */
+    unsigned long frames() const;
+
+private:
+    /** In-memory canvas */
+    class Canvas : public DisplayCanvas {
+    public:
+        Canvas(int width, int height, uint8_t brightness);
+        void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b);
+        void setBrightness(uint8_t percent);
+        uint8_t brightness() const;
+
+        std::vector<uint8_t> rgb;   // Packed RGB, row-major
+
+    private:
+        int width_;                 // Width in pixels
+        int height_;                // Height in pixels
+        uint8_t brightness_;        // Brightness of written pixels
+    };
+
+    int width_;                     // Width in pixels
+    int height_;                    // Height in pixels
+    Canvas canvases_[2];            // Shown and offscreen canvas
+    int front_;                     // Index of the shown canvas
+    uint8_t brightness_;            // Panel brightness
+    unsigned long frames_;          // swap() count
+};
+
+#endif // HEADLESS_DISPLAY_H
@@ -0,0 +1,119 @@
+#ifndef INPUT_MANAGER_H
+#define INPUT_MANAGER_H
+
+#include "Config.h"
+#include "GPIOButton.h"
+#include "GPIOChipGroup.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Multi-Button Input Manager
+ * Owns every configured button. With the gpiochip backend all lines are
+ * requested in one GPIOChipGroup and sampled with a single
+ * GPIO_V2_LINE_GET_VALUES ioctl per pass, then each line's gesture state
+ * machine (GPIOButton) runs on the cached values and demultiplexed edges.
+ * Other backends (gpiomem, pinctrl, sim) get one backend instance per button.
+ *
+ * With start(), a dedicated input thread blocks in epoll on the edge fds,
+ * wakes at the earliest pending gesture deadline, and hands decoded
+ * events to the render loop through each button's lock-free SPSC ring.
+ */
+class InputManager {
+public:
+    /**
+     * Constructor
+     * @param backend_spec Backend spec (see createGPIOBackend)
+     * @param buttons Buttons to manage (name + pin)
+     * @param timing Gesture timing windows shared by all buttons
+     */
+    InputManager(const std::string& backend_spec, const std::vector<ButtonConfig>& buttons,
+                 const GestureTiming& timing = GestureTiming());
+
+    /**
+     * Destructor - stops the input thread
+     */
+    ~InputManager();
+
+    /**
+     * Request the lines and set up every button
+     * @return true if all buttons were set up
+     */
+    bool setup();
+
+    /**
+     * Look up a button by its configured name
+     * @param name Button name (e.g., "main")
+     * @return Button, or nullptr if not configured
+     */
+    GPIOButton* button(const std::string& name);
+
+    /**
+     * Set an observer called before every button callback (see GPIOButton::onDispatch)
+     * @param observer Function receiving the event being dispatched
+     */
+    void onDispatch(std::function<void(const ButtonEvent&)> observer);
+
+    /**
+     * Set an eventfd the input thread signals after queuing events
+     * Lets the render loop sleep until there is input to dispatch.
+     * @param fd eventfd (e.g., FrameScheduler::notifyFd), or -1 for none
+     */
+    void setNotifyFd(int fd);
+
+    /**
+     * Start the interrupt-driven input thread
+     * Requires edge-capable backends; set callbacks before calling
+     * @return true if the thread is running, false to keep using polling
+     */
+    bool start();
+
+    /**
+     * Stop the input thread (no-op if not running)
+     */
+    void stop();
+
+    /**
+     * Dispatch button events - call this regularly in main loop
+     * Polling mode: samples all lines once and runs every state machine.
+     * Threaded mode: drains decoded events only; never blocks.
+     * @param current_time_ms Current time in milliseconds (CLOCK_MONOTONIC)
+     */
+    void poll(long current_time_ms);
+
+    /**
+     * Name of the backend in use (after fallbacks)
+     * @return Backend name
+     */
+    const char* backendName() const;
+
+private:
+    /**
+     * Sample all lines once and run every button's state machine
+     * @param current_time_ms Current time in milliseconds
+     */
+    void process(long current_time_ms);
+
+    /**
+     * Input thread body: epoll on edge fds with a timeout at the next deadline
+     */
+    void threadLoop();
+
+    std::string backend_spec_;                          // Backend spec from config
+    std::vector<ButtonConfig> configs_;                 // Button definitions
+    GestureTiming timing_;                              // Gesture timing windows
+    std::unique_ptr<GPIOChipGroup> group_;              // Shared line request (gpiochip backend)
+    std::vector<std::unique_ptr<GPIOButton> > buttons_; // One state machine per line
+
+    // Input thread
+    std::thread thread_;                                // Input thread
+    std::atomic<bool> running_;                         // True while the input thread runs
+    int stop_fd_;                                       // eventfd used to wake the thread for shutdown
+    int epoll_fd_;                                      // epoll set: edge fds + stop_fd_
+    int notify_fd_;                                     // eventfd signalled after queuing events (-1 = none)
+};
+
+#endif // INPUT_MANAGER_H
@@ -0,0 +1,67 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include "Histogram.h"
+#include <cstdio>
+#include <stdint.h>
+
+/**
+ * Edge-to-Photon Input Latency Tracker
+ * Follows one input from the GPIO edge to the frame that shows its effect:
+ *   edge      - kernel edge timestamp carried by the ButtonEvent (ms resolution)
+ *   dispatch  - the logic loop invokes the gesture callback
+ *   composed  - the frame reflecting the callback is fully drawn
+ *   presented - SwapOnVSync returned with that frame
+ * Each span is aggregated into a fixed-bucket histogram (microseconds);
+ * report() prints count, p50/p95/p99 and max for each of them.
+ * All calls happen on the render thread; the edge and dispatch times
+ * reach it with the frame that shows the input (see FrameState).
+ */
+class LatencyTracker {
+public:
+    /**
+     * Constructor - initializes empty histograms
+     */
+    LatencyTracker();
+
+    /**
+     * A gesture callback is about to run
+     * @param edge_ms Gesture edge timestamp in milliseconds (CLOCK_MONOTONIC)
+     * @param now_us Current time in microseconds (CLOCK_MONOTONIC)
+     */
+    void inputDispatched(long edge_ms, int64_t now_us);
+
+    /**
+     * The current frame has been drawn (before the swap)
+     * @param now_us Current time in microseconds
+     */
+    void frameComposed(int64_t now_us);
+
+    /**
+     * The swap of the current frame returned
+     * @param now_us Current time in microseconds
+     */
+    void framePresented(int64_t now_us);
+
+    /**
+     * Print the latency histograms
+     * @param out Output stream
+     */
+    void report(FILE* out) const;
+
+private:
+    // Input waiting for its frame (only the oldest input of a frame is tracked)
+    bool pending_;          // An input was dispatched and not yet presented
+    bool composed_;         // The pending input's frame has been drawn
+    int64_t edge_us_;       // Edge timestamp
+    int64_t dispatch_us_;   // Callback dispatch timestamp
+    int64_t composed_us_;   // Frame composition timestamp
+
+    // Span histograms (microseconds)
+    Histogram input_;       // edge -> dispatch
+    Histogram compose_;     // dispatch -> composed (callback + drawing)
+    Histogram swap_;        // composed -> presented
+    Histogram total_;       // edge -> presented
+};
+
+#endif // LATENCY_TRACKER_H
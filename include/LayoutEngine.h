@@ -0,0 +1,137 @@
+#ifndef LAYOUT_ENGINE_H
+#define LAYOUT_ENGINE_H
+
+#include "Config.h"
+#include "TextMeasurer.h"
+#include "WordWrap.h"
+#include "BitmapFont.h"
+#include <string>
+#include <vector>
+
+/**
+ * Positioned text run
+ * One line of text: font, baseline origin and text
+ */
+struct TextRun {
+    const BitmapFont* font;        // Font to draw with
+    int x, y;                      // Left edge and baseline (DrawText coordinates)
+    std::string text;              // UTF-8 text
+};
+
+/**
+ * Cached layout of one screen
+ * The render loop replays the runs in order.
+ */
+struct Layout {
+    std::vector<TextRun> runs;     // Positioned text runs
+};
+
+/**
+ * Date/Time Layout Engine
+ * Turns the formatted date and time strings into positioned text runs
+ * (vertical centering with the ignoreDescenders heights, spacing clamped to
+ * the display, horizontal centering, greedy or balanced word wrap of a
+ * date-only display).
+ *
+ * The clock layout is cached and only recomputed when the date string, the
+ * time string's width, the fonts or the layout config fields change; a new
+ * time string of the same width only replaces the text of its run.
+ */
+class LayoutEngine {
+public:
+    /**
+     * Constructor
+     * @param config Configuration (show flags, ignoreDescenders, spacing)
+     * @param date_font Font of the date
+     * @param time_font Font of the time
+     * @param measurer Text measurement cache
+     * @param width Display width in pixels
+     * @param height Display height in pixels
+     */
+    LayoutEngine(const Config& config, const BitmapFont& date_font, const BitmapFont& time_font,
+                 TextMeasurer& measurer, int width, int height);
+
+    /**
+     * Layout of the clock screen
+     * @param date Formatted (uppercased) date
+     * @param time Formatted time
+     * @return Cached layout, valid until the next call
+     */
+    const Layout& clock(const char* date, const char* time);
+
+    /**
+     * Layout of a single horizontally centered line (messages)
+     * @param font Font to draw with
+     * @param text UTF-8 text
+     * @param y Baseline position
+     * @return Cached layout, valid until the next call
+     */
+    const Layout& centered(const BitmapFont& font, const char* text, int y);
+
+    /**
+     * Index of the time run in the clock layout
+     * @return Run index, or -1 if the time is not shown
+     */
+    int timeRun() const;
+
+    /**
+     * Number of times the clock layout was recomputed
+     * Unchanged between two clock() calls = every run kept its position.
+     * @return Layout generation
+     */
+    unsigned generation() const;
+
+private:
+    /**
+     * Recompute the clock layout from scratch
+     * @param date Formatted date
+     * @param time Formatted time
+     * @param time_width Width of the time string
+     */
+    void layoutClock(const char* date, const char* time, int time_width);
+
+    /**
+     * Append word-wrapped, centered date lines (config dateWrap mode)
+     * @param date Formatted date (wider than the display)
+     */
+    void wrapDate(const char* date);
+
+    /**
+     * Append a run
+     * @param layout Layout to append to
+     * @param font Font
+     * @param x Left edge
+     * @param y Baseline
+     * @param text Text
+     */
+    static void addRun(Layout& layout, const BitmapFont& font, int x, int y, const std::string& text);
+
+    const Config& config_;                // Layout config fields
+    const BitmapFont& date_font_;         // Date font
+    const BitmapFont& time_font_;         // Time font
+    TextMeasurer& measurer_;              // Text widths
+    int width_;                           // Display width
+    int height_;                          // Display height
+
+    // Clock layout and the inputs it was computed from
+    Layout clock_;                        // Cached clock layout
+    bool clock_valid_;                    // False until the first layout
+    unsigned generation_;                 // Incremented on every relayout
+    int time_run_;                        // Index of the time run in clock_ (-1 = none)
+    std::string date_;                    // Date string
+    int time_width_;                      // Time string width
+    bool show_date_, show_time_;          // Visibility flags
+    bool date_ignore_descenders_;         // Date ignoreDescenders flag
+    bool time_ignore_descenders_;         // Time ignoreDescenders flag
+    int spacing_;                         // Configured date/time spacing
+    std::string date_wrap_;               // Configured date wrap mode
+    WordWrap wrap_;                       // Date-only word wrap (runs only on relayout)
+
+    // Centered message layout
+    Layout message_;                      // Cached message layout
+    bool message_valid_;                  // False until the first layout
+    const BitmapFont* message_font_;      // Message font
+    int message_y_;                       // Message baseline
+};
+
+#endif // LAYOUT_ENGINE_H
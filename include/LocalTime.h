@@ -0,0 +1,128 @@
+#ifndef LOCAL_TIME_H
+#define LOCAL_TIME_H
+
+#include <ctime>
+#include <string>
+
+#define LOCAL_TIME_SCAN_DAYS 400            // How far ahead the next UTC offset change is searched (days)
+#define LOCAL_TIME_MAX_WATCHES 2            // Zone file directories watched (link and its target)
+
+/**
+ * Cached Local Time Service
+ * Replaces a localtime() call per frame (which re-checks TZ and may stat
+ * the zone file every time) with plain arithmetic on CLOCK_REALTIME:
+ * - the UTC offset, DST flag and zone abbreviation are taken once from
+ *   localtime_r() and stay valid until the next offset transition, which
+ *   is located by a coarse daily scan plus a binary search to the second
+ * - in between, the broken-down time is derived from UTC seconds + offset
+ *   with civil-from-days arithmetic
+ * - the zone is reloaded when that transition is reached, when the clock is
+ *   set before the current period, or when /etc/localtime changes (inotify,
+ *   checked once per second; with TZ set the zone is fixed until restart)
+ *
+ * Zones where the arithmetic does not reproduce localtime_r() (leap-second
+ * "right/" zones) are detected on reload and fall back to localtime_r().
+ * The scan probes once a day, so a change that is reverted before the next
+ * probe (A -> B -> A within a day) is missed entirely: the cached offset
+ * stays A for the whole B window.
+ */
+class LocalTime {
+public:
+    /**
+     * Constructor - nothing is loaded until the first conversion
+     */
+    LocalTime();
+
+    /**
+     * Destructor - closes the inotify fd
+     */
+    ~LocalTime();
+
+    /**
+     * Watch /etc/localtime for changes
+     * @return true if a watch was added (false if TZ is set or inotify is
+     *         unavailable; conversions still work)
+     */
+    bool setup();
+
+    /**
+     * Current local time
+     * @return Broken-down local time (valid until the next call)
+     */
+    const struct tm& now();
+
+    /**
+     * Convert a UTC time to local time
+     * @param t Seconds since the epoch
+     * @return Broken-down local time, same fields as localtime_r()
+     */
+    const struct tm& at(time_t t);
+
+    /**
+     * First second at which the current UTC offset stops applying
+     * @return Seconds since the epoch (end of the scan window if no change was found)
+     */
+    time_t nextTransition() const;
+
+    /**
+     * Number of zone reloads so far
+     * @return Reload count
+     */
+    unsigned long reloads() const;
+
+    /**
+     * Whether conversions use the cached-offset arithmetic
+     * @return false if the loaded zone falls back to localtime_r()
+     */
+    bool exact() const;
+
+private:
+    /**
+     * Load the offset period containing t
+     * @param t Seconds since the epoch
+     */
+    void reload(time_t t);
+
+    /**
+     * Fill tm_ from t with the cached offset
+     * @param t Seconds since the epoch
+     */
+    void convert(time_t t);
+
+    /**
+     * Drain the inotify fd
+     * @return true if the zone file changed
+     */
+    bool zoneChanged();
+
+    /**
+     * Make the C library re-read /etc/localtime (safe with other threads converting)
+     */
+    static void reloadZone();
+
+    /**
+     * Add an inotify watch on the directory of a zone file
+     * @param path Zone file path
+     * @return true if the watch was added
+     */
+    bool watchFile(const std::string& path);
+
+    time_t valid_from_;         // First second of the cached offset period
+    time_t valid_until_;        // First second past it (valid_from_ = valid_until_ = nothing loaded)
+    long gmtoff_;               // UTC offset of the period (seconds east)
+    int isdst_;                 // DST flag of the period
+    char zone_[16];             // Zone abbreviation of the period
+    bool exact_;                // Arithmetic matches localtime_r() in this zone
+    bool warned_;               // Fallback warning already printed for the loaded zone
+
+    struct tm tm_;              // Last conversion
+    time_t tm_time_;            // UTC second of tm_ (-1 = none)
+    unsigned long reloads_;     // Reload count
+
+    int inotify_fd_;                                // inotify fd (-1 = not watching)
+    int watches_;                                   // Watches in use
+    int watch_wd_[LOCAL_TIME_MAX_WATCHES];          // Watch descriptors (directories)
+    std::string watch_name_[LOCAL_TIME_MAX_WATCHES]; // File name watched in each directory
+};
+
+#endif // LOCAL_TIME_H
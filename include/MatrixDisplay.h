@@ -0,0 +1,67 @@
+#ifndef MATRIX_DISPLAY_H
+#define MATRIX_DISPLAY_H
+
+#include "Display.h"
+#include "led-matrix.h"
+#include <memory>
+#include <vector>
+
+/**
+ * LED Matrix Display
+ * The HUB75 panel driven by rpi-rgb-led-matrix (Adafruit bonnet mapping):
+ * an offscreen FrameCanvas is swapped in with SwapOnVSync. Needs root for
+ * the GPIO registers and starts the library's refresh thread.
+ */
+class MatrixDisplay : public Display {
+public:
+    /**
+     * Constructor
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @param brightness Initial brightness (%)
+     */
+    MatrixDisplay(int width, int height, int brightness);
+
+    /**
+     * Destructor - stops the refresh thread and releases the matrix
+     */
+    ~MatrixDisplay();
+
+    bool setup();
+    int width() const;
+    int height() const;
+    DisplayCanvas* offscreen();
+    void swap();
+    void setBrightness(uint8_t percent);
+    void clear();
+    const char* name() const { return "matrix"; }
+
+private:
+    /** FrameCanvas adapter */
+    class Canvas : public DisplayCanvas {
+    public:
+        explicit Canvas(rgb_matrix::FrameCanvas* canvas) : canvas(canvas) {}
+        void setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) { canvas->SetPixel(x, y, r, g, b); }
+        void setBrightness(uint8_t percent) { canvas->SetBrightness(percent); }
+        uint8_t brightness() const { return canvas->brightness(); }
+
+        rgb_matrix::FrameCanvas* canvas;   // Wrapped canvas (owned by the matrix)
+    };
+
+    /**
+     * Adapter of a FrameCanvas (created the first time it is seen, so the
+     * same canvas always maps to the same DisplayCanvas)
+     * @param canvas Canvas returned by the matrix
+     * @return Adapter
+     */
+    Canvas* wrap(rgb_matrix::FrameCanvas* canvas);
+
+    int width_;                                       // Width in pixels
+    int height_;                                      // Height in pixels
+    int brightness_;                                  // Initial brightness
+    rgb_matrix::RGBMatrix* matrix_;                   // Matrix (nullptr until setup())
+    std::vector<std::unique_ptr<Canvas> > canvases_;  // Adapters of the canvases in the swap rotation
+    Canvas* offscreen_;                               // Canvas drawn next
+};
+
+#endif // MATRIX_DISPLAY_H
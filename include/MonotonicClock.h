@@ -0,0 +1,48 @@
+#ifndef MONOTONIC_CLOCK_H
+#define MONOTONIC_CLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * Read a clock in microseconds
+ * @param clock Clock id (CLOCK_REALTIME for wall-clock lateness)
+ * @return Microseconds since the clock's epoch
+ */
+inline int64_t clockUs(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * CLOCK_MONOTONIC in microseconds
+ * Time base of frame timing, latency, recording and frame statistics
+ * @return Microseconds since boot
+ */
+inline int64_t monotonicUs() {
+    return clockUs(CLOCK_MONOTONIC);
+}
+
+/**
+ * CLOCK_MONOTONIC in milliseconds
+ * Same base as the kernel GPIO edge timestamps and the gesture deadlines
+ * @return Milliseconds since boot
+ */
+inline long monotonicMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * CLOCK_MONOTONIC in nanoseconds (benchmarks and the render sweep)
+ * @return Nanoseconds since boot
+ */
+inline int64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+#endif // MONOTONIC_CLOCK_H
@@ -0,0 +1,28 @@
+#ifndef PINCTRL_BACKEND_H
+#define PINCTRL_BACKEND_H
+
+#include "GPIOBackend.h"
+
+/**
+ * pinctrl CLI Backend
+ * Legacy backend: configures the pin with "pinctrl set" and reads it by
+ * running "pinctrl lev" through popen (one fork+exec per read).
+ * Kept as a fallback for kernels without the GPIO character device.
+ */
+class PinctrlBackend : public GPIOBackend {
+public:
+    /**
+     * Constructor
+     * @param pin GPIO pin number
+     */
+    explicit PinctrlBackend(int pin);
+
+    bool setup();
+    int read();
+    const char* name() const { return "pinctrl"; }
+
+private:
+    int pin_;   // GPIO pin number
+};
+
+#endif // PINCTRL_BACKEND_H
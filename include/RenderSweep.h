@@ -0,0 +1,86 @@
+#ifndef RENDER_SWEEP_H
+#define RENDER_SWEEP_H
+
+#include <stdint.h>
+#include <string>
+
+#define RENDER_SWEEP_TIME 1735689598        // Fixed instant of the sweep (2024-12-31 23:59:58 UTC)
+
+/**
+ * Golden-Frame Render Sweep
+ * Renders the clock screen for a fixed matrix of configurations at a fixed
+ * instant: every BDF font in a directory (used for both date and time) x
+ * date+time (descenders ignored / kept, two spacings), date only with
+ * greedy and balanced wrap of a long date, and time only. Frames go
+ * through the same path as the clock (LayoutEngine, Scene, FrameBuffer).
+ *
+ * Each frame is compared byte for byte with "<font>-<case>.ppm" in the
+ * golden directory; a missing golden counts as a mismatch. In update mode
+ * missing and differing goldens are written instead (make golden-update).
+ * Dates are formatted in the "C" locale so the golden set does not depend
+ * on the build locale or on the locales installed. The render time is
+ * reported separately from file I/O, so the sweep doubles as a rendering
+ * throughput measurement.
+ */
+class RenderSweep {
+public:
+    /**
+     * Constructor
+     * @param font_dir Directory with the .bdf fonts (with trailing slash)
+     * @param golden_dir Directory of the golden PPM frames
+     * @param width Display width in pixels
+     * @param height Display height in pixels
+     * @param update Write missing and differing goldens instead of failing
+     */
+    RenderSweep(const std::string& font_dir, const std::string& golden_dir, int width, int height, bool update);
+
+    /**
+     * Render, compare and report every configuration
+     * @return Number of frames that differ from their golden (-1 on error)
+     */
+    int run();
+
+private:
+    /** One layout configuration */
+    struct Case {
+        const char* name;           // File name suffix
+        bool show_date;             // showDate
+        bool show_time;             // showTime
+        bool ignore_descenders;     // date/timeIgnoreDescenders
+        int spacing;                // dateTimeSpacing
+        const char* date_format;    // dateFormat
+        const char* wrap;           // dateWrap
+    };
+
+    /**
+     * Compare a frame with its golden (in update mode, write it if missing or different)
+     * @param name Golden file name (in golden_dir_)
+     * @param rgb Packed RGB frame
+     * @param written Set to true if the golden was written
+     * @return true if the frame matches (or was written)
+     */
+    bool check(const std::string& name, const uint8_t* rgb, bool& written);
+
+    /**
+     * Write a golden file
+     * @param path File path
+     * @param ppm PPM file contents
+     * @return true on success
+     */
+    bool writeGolden(const std::string& path, const std::string& ppm);
+
+    /**
+     * Encode a frame as a binary PPM
+     * @param rgb Packed RGB frame
+     * @return PPM file contents
+     */
+    std::string encode(const uint8_t* rgb) const;
+
+    std::string font_dir_;          // Font directory
+    std::string golden_dir_;        // Golden frame directory
+    int width_;                     // Display width
+    int height_;                    // Display height
+    bool update_;                   // Write goldens instead of failing
+};
+
+#endif // RENDER_SWEEP_H
@@ -0,0 +1,180 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "Animator.h"
+#include "BitmapFont.h"
+#include "BorderSnakeAnimation.h"
+#include "Compositor.h"
+#include "Display.h"
+#include "FrameBuffer.h"
+#include "FrameRecorder.h"
+#include "FrameStats.h"
+#include "LatencyTracker.h"
+#include "LayoutEngine.h"
+#include "Scene.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/** What the base frame shows (brightness/color messages are an overlay) */
+enum FrameContent {
+    SHOW_CLOCK,    // Date and/or time
+    SHOW_AUTO      // AUTO label during the transition back to AUTO mode
+};
+
+/**
+ * Immutable description of one frame
+ * Filled by the logic thread, drawn by the render thread. Every field is
+ * set for every frame (the triple buffer reuses its slots).
+ */
+struct FrameState {
+    FrameContent content;                            // Base screen
+    RGBColor color;                                  // Text color of the base screen
+    std::string date;                                // Formatted date (SHOW_CLOCK)
+    std::string time;                                // Formatted time (SHOW_CLOCK)
+    std::string label;                               // Centered label (SHOW_AUTO)
+    std::string message;                             // Message overlay text
+    RGBColor message_color;                          // Message overlay color
+    uint8_t message_opacity;                         // Message overlay opacity (0 = hidden)
+    std::vector<std::pair<Point, RGBColor> > snake;  // Border snake pixels
+    int brightness;                                  // Panel brightness (%)
+    long input_edge_ms;                              // Oldest input this frame reflects: edge time (ms)
+    int64_t input_dispatch_us;                       // ... and its dispatch time (us, 0 = none)
+};
+
+/**
+ * Render Thread
+ * Takes frame descriptions from the logic thread through a lock-free triple
+ * buffer and turns them into pixels: layout, scene, overlay compositing,
+ * canvas transfer and the display swap. The logic thread (input, color
+ * scheduling, logging) never waits for a frame; frames published faster
+ * than they are drawn are replaced by the newest. Config saves run on
+ * their own thread (ConfigSaver) so they never delay a publish either.
+ *
+ * After start(), the layout engine, framebuffer and display belong to the
+ * render thread until stop().
+ */
+class Renderer {
+public:
+    /**
+     * Constructor
+     * @param display Display (swap, brightness)
+     * @param framebuffer Frame transferred to the canvases
+     * @param layout Layout engine for the clock and message screens
+     * @param message_font Font of the message and AUTO screens
+     */
+    Renderer(Display* display, FrameBuffer& framebuffer, LayoutEngine& layout, const BitmapFont& message_font);
+
+    /**
+     * Destructor - stops the render thread
+     */
+    ~Renderer();
+
+    /**
+     * Record every frame drawn from now on (call before start())
+     * @param recorder Open recorder (not owned), or nullptr to stop recording
+     */
+    void setRecorder(FrameRecorder* recorder);
+
+    /**
+     * Time the render stages of every frame from now on (call before start())
+     * @param stats Stage statistics (not owned), or nullptr for none
+     */
+    void setStats(FrameStats* stats);
+
+    /**
+     * Start the render thread
+     * @return true if the thread is running
+     */
+    bool start();
+
+    /**
+     * Stop and join the render thread (no-op if not running)
+     */
+    void stop();
+
+    /**
+     * Frame description to fill next (logic thread only)
+     * @return Back slot of the triple buffer
+     */
+    FrameState& next();
+
+    /**
+     * Hand the filled frame to the render thread (logic thread only)
+     */
+    void publish();
+
+    /**
+     * Dispatch time of the latest input the render thread has taken
+     * @return Dispatch time in microseconds (0 = none yet)
+     */
+    int64_t inputTaken() const;
+
+    /**
+     * Number of frames drawn
+     * @return Frame count
+     */
+    unsigned long framesDrawn() const;
+
+    /**
+     * Ask the render thread to print the latency histograms
+     */
+    void requestReport();
+
+    /**
+     * Print the latency histograms (call after stop())
+     * @param out Output stream
+     */
+    void report(FILE* out) const;
+
+private:
+    /**
+     * Render thread body: wait for a frame, draw the newest one
+     */
+    void threadLoop();
+
+    /**
+     * Draw a frame and swap it onto the panel
+     * @param state Frame description
+     */
+    void render(const FrameState& state);
+
+    Display* display_;                    // Display
+    FrameBuffer& framebuffer_;            // Composited frame
+    LayoutEngine& layout_;                // Layouts
+    const BitmapFont& message_font_;      // Message/AUTO font
+
+    // Pipeline: scene (base text) + overlay layers
+    Scene scene_;                         // Retained base scene
+    FrameBuffer scene_buffer_;            // Scene output
+    LayoutNode* text_node_;               // Text of the base screen (owned by scene_)
+    Compositor compositor_;               // Overlay compositor
+    int message_layer_;                   // Message layer (faded)
+    int snake_layer_;                     // Border snake layer (top)
+    std::string message_layer_text_;      // Message drawn in message_layer_
+    RGBColor message_layer_color_;        // Its color
+    bool snake_drawn_;                    // snake_layer_ holds pixels
+    FrameRecorder* recorder_;             // Records the composed frames (nullptr = off)
+    FrameStats* stats_;                   // Render stage timings (nullptr = off)
+
+    // Handoff
+    TripleBuffer<FrameState> frames_;     // Logic -> render
+    std::thread thread_;                  // Render thread
+    std::atomic<bool> running_;           // True while the thread runs
+    std::atomic<bool> stopping_;          // Asks the thread to exit
+    std::atomic<bool> report_requested_;  // Print the histograms on the render thread
+    int wake_fd_;                         // eventfd: a frame was published (or stop/report)
+
+    // Statistics (render thread)
+    LatencyTracker latency_;              // Edge-to-photon latency
+    int64_t last_input_us_;               // Dispatch time of the last input recorded
+    std::atomic<int64_t> input_taken_;    // Published copy of last_input_us_
+    std::atomic<unsigned long> drawn_;    // Frames drawn
+};
+
+#endif // RENDERER_H
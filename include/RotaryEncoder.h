@@ -0,0 +1,115 @@
+#ifndef ROTARY_ENCODER_H
+#define ROTARY_ENCODER_H
+
+#include "GPIOBackend.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+/**
+ * Quadrature Rotary Encoder Input
+ * Decodes the A/B channels of an incremental encoder into detent steps.
+ *
+ * With the gpiochip backend both lines are requested together and an input
+ * thread blocks in epoll on their edge events; the kernel delivers edges of
+ * both lines in order, so every transition goes through the quadrature
+ * state table without missed steps at >1 kHz edge rates. The only shared
+ * state is an atomic detent counter that the render loop drains with
+ * poll(), so fast spinning costs the main loop nothing extra.
+ *
+ * Other backends (gpiomem, pinctrl, sim scripts with "press" = low) are
+ * polled from poll(): pending edges of both channels are merged by
+ * timestamp before decoding.
+ */
+class RotaryEncoder {
+public:
+    /**
+     * Constructor
+     * @param backend_spec Backend spec (see createGPIOBackend)
+     * @param pin_a GPIO pin of channel A
+     * @param pin_b GPIO pin of channel B
+     * @param steps_per_detent Quadrature transitions per mechanical detent (default: 4)
+     */
+    RotaryEncoder(const std::string& backend_spec, int pin_a, int pin_b, int steps_per_detent = 4);
+
+    /**
+     * Destructor - stops the input thread and releases the lines
+     */
+    ~RotaryEncoder();
+
+    /**
+     * Request both lines with pull-up
+     * @return true if setup successful, false otherwise
+     */
+    bool setup();
+
+    /**
+     * Start the interrupt-driven decoder thread (gpiochip backend only)
+     * @return true if the thread is running, false to keep using polling
+     */
+    bool start();
+
+    /**
+     * Stop the decoder thread (no-op if not running)
+     */
+    void stop();
+
+    /**
+     * Take the detents accumulated since the last call - never blocks
+     * @return Detent count (positive = clockwise, A leads B)
+     */
+    int poll();
+
+    /**
+     * Set an eventfd the decoder thread signals when detents are pending
+     * @param fd eventfd (e.g., FrameScheduler::notifyFd), or -1 for none
+     */
+    void setNotifyFd(int fd);
+
+private:
+    /**
+     * Run one A/B state through the quadrature table
+     * @param state New state (bit 1 = A, bit 0 = B)
+     */
+    void feed(int state);
+
+    /**
+     * Decode all pending chardev edge events in kernel order
+     */
+    void readEvents();
+
+    /**
+     * Decode pending edges of the polled backends, merged by timestamp
+     */
+    void processBackends();
+
+    /**
+     * Decoder thread body: epoll on the line request fd
+     */
+    void threadLoop();
+
+    // Configuration
+    std::string backend_spec_;      // Backend spec from config
+    int pin_a_;                     // Channel A pin
+    int pin_b_;                     // Channel B pin
+    int steps_per_detent_;          // Transitions per detent
+
+    // Line sources
+    int line_fd_;                               // Two-line chardev request (-1 = polled backends)
+    std::unique_ptr<GPIOBackend> backend_a_;    // Channel A (polled backends)
+    std::unique_ptr<GPIOBackend> backend_b_;    // Channel B (polled backends)
+
+    // Decoder state (owned by the thread that decodes)
+    int state_;                     // Last A/B state
+    int transitions_;               // Transitions accumulated toward the next detent
+    std::atomic<int> detents_;      // Detents not yet taken by poll()
+
+    // Decoder thread
+    std::thread thread_;            // Decoder thread
+    std::atomic<bool> running_;     // True while the decoder thread runs
+    int stop_fd_;                   // eventfd used to wake the thread for shutdown
+    int notify_fd_;                 // eventfd signalled when detents are pending (-1 = none)
+};
+
+#endif // ROTARY_ENCODER_H
@@ -0,0 +1,441 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include "Animator.h"
+#include "BitmapFont.h"
+#include "BorderSnakeAnimation.h"
+#include "DigitSprites.h"
+#include "FrameBuffer.h"
+#include "LayoutEngine.h"
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define SCENE_MAX_DAMAGE 8                  // Damage rectangles kept per frame (more are merged)
+
+/**
+ * Rectangle [x0, x1) x [y0, y1); empty when x0 >= x1 or y0 >= y1
+ */
+struct SceneRect {
+    int x0, y0, x1, y1;
+
+    /** Default constructor - empty rectangle */
+    SceneRect() : x0(0), y0(0), x1(0), y1(0) {}
+
+    /**
+     * Constructor
+     * @param left Left column
+     * @param top Top row
+     * @param right One past the right column
+     * @param bottom One past the bottom row
+     */
+    SceneRect(int left, int top, int right, int bottom) : x0(left), y0(top), x1(right), y1(bottom) {}
+
+    /** @return true if the rectangle holds no pixel */
+    bool empty() const { return x0 >= x1 || y0 >= y1; }
+
+    /** @return Number of pixels */
+    int area() const { return empty() ? 0 : (x1 - x0) * (y1 - y0); }
+
+    /**
+     * Whether two rectangles share a pixel
+     * @param other Other rectangle
+     * @return true if they overlap
+     */
+    bool intersects(const SceneRect& other) const;
+
+    /**
+     * Smallest rectangle holding both
+     * @param other Other rectangle
+     * @return Union bounds
+     */
+    SceneRect unite(const SceneRect& other) const;
+};
+
+class LayerNode;
+
+/**
+ * Retained Scene Node
+ * Base of everything drawn by the Scene. A node knows its bounds and the
+ * area it covered in the last composed frame; a setter that changes what
+ * the node shows marks it dirty, which is propagated up to the root so
+ * clean subtrees are skipped when the damage is collected.
+ *
+ * Nodes are created by the caller and owned by the LayerNode they are
+ * added to.
+ */
+class SceneNode {
+public:
+    /**
+     * Constructor - visible, empty bounds, dirty
+     */
+    SceneNode();
+
+    /**
+     * Destructor
+     */
+    virtual ~SceneNode();
+
+    /**
+     * Show or hide the node
+     * @param visible true to draw the node
+     */
+    void setVisible(bool visible);
+
+    /**
+     * @return true if the node is drawn
+     */
+    bool visible() const;
+
+    /**
+     * Current bounds (layers: union of the children, updated by compose)
+     * @return Bounds in display pixels
+     */
+    const SceneRect& bounds() const;
+
+    /**
+     * @return true if the node (or a child of a layer) changed since the last compose
+     */
+    bool dirty() const;
+
+protected:
+    /**
+     * Mark the node changed (and its parents as holding a changed child)
+     */
+    void changed();
+
+    /**
+     * The node as a layer (no RTTI lookup on the compose path)
+     * @return this for a LayerNode, nullptr otherwise
+     */
+    virtual LayerNode* layer();
+
+    /**
+     * Set the bounds of the node (call from setters, then changed())
+     * @param bounds New bounds
+     */
+    void setBounds(const SceneRect& bounds);
+
+    /**
+     * Draw the node; the framebuffer clip limits it to the damaged area
+     * @param fb Framebuffer
+     */
+    virtual void render(FrameBuffer& fb) const = 0;
+
+    /**
+     * Report the area to recompose for a dirty node
+     * Default: the area drawn last frame and the current bounds.
+     * @param damage Damage list to add to
+     */
+    virtual void damage(std::vector<SceneRect>& damage) const;
+
+    /**
+     * Forget the change after a compose
+     */
+    virtual void settle();
+
+    /**
+     * Add a rectangle to a damage list, merging into overlapping entries
+     * @param damage Damage list (at most SCENE_MAX_DAMAGE entries)
+     * @param rect Rectangle to add
+     */
+    static void addDamage(std::vector<SceneRect>& damage, const SceneRect& rect);
+
+    LayerNode* parent_;     // Layer holding the node (nullptr for the root)
+    SceneRect bounds_;      // Current bounds
+    SceneRect drawn_;       // Area covered in the last composed frame (empty = not drawn)
+    bool visible_;          // Node is drawn
+    bool dirty_;            // Changed since the last compose
+
+    friend class LayerNode;
+    friend class Scene;
+};
+
+/**
+ * Text node: one line of UTF-8 text in a bitmap font
+ * When only some characters change (same font, position, color and cell
+ * widths, as with the time digits), only the changed glyph cells are
+ * damaged.
+ */
+class TextNode : public SceneNode {
+public:
+    /**
+     * Constructor - empty text
+     */
+    TextNode();
+
+    /**
+     * Set the text and its style (no change = no damage)
+     * @param font Font
+     * @param x Pen position (left edge)
+     * @param y Baseline
+     * @param color Text color
+     * @param text UTF-8 text
+     */
+    void set(const BitmapFont& font, int x, int y, const RGBColor& color, const char* text);
+
+protected:
+    void render(FrameBuffer& fb) const;
+    void damage(std::vector<SceneRect>& damage) const;
+    void settle();
+
+private:
+    const BitmapFont* font_;          // Font (nullptr = nothing set)
+    int x_, y_;                       // Pen position and baseline
+    RGBColor color_;                  // Text color
+    std::string text_;                // Text
+    std::vector<uint32_t> cells_;     // Code point of each glyph cell
+    std::vector<int> advances_;       // Advance of each glyph cell
+    std::vector<uint32_t> next_cells_;    // Spare buffer for the cells of a new text (swapped with cells_)
+    std::vector<int> next_advances_;      // Spare buffer for its advances (swapped with advances_)
+    std::vector<SceneRect> changed_cells_;  // Cells changed in place since the last compose
+    bool partial_;                    // Only changed_cells_ need recomposing
+};
+
+/**
+ * Rectangle node: solid fill
+ */
+class RectNode : public SceneNode {
+public:
+    /**
+     * Set the rectangle
+     * @param x Left column
+     * @param y Top row
+     * @param w Width
+     * @param h Height
+     * @param color Fill color
+     */
+    void set(int x, int y, int w, int h, const RGBColor& color);
+
+protected:
+    void render(FrameBuffer& fb) const;
+
+private:
+    RGBColor color_;                  // Fill color
+};
+
+/**
+ * Sprite node: packed RGB image (black pixels are drawn as black)
+ */
+class SpriteNode : public SceneNode {
+public:
+    /**
+     * Constructor - no image
+     */
+    SpriteNode();
+
+    /**
+     * Set the image (copied)
+     * @param x Left column
+     * @param y Top row
+     * @param w Image width
+     * @param h Image height
+     * @param rgb Packed RGB pixels, row-major
+     */
+    void set(int x, int y, int w, int h, const uint8_t* rgb);
+
+    /**
+     * Show an image owned by the caller (not copied; no change = no damage)
+     * @param x Left column
+     * @param y Top row
+     * @param w Image width
+     * @param h Image height
+     * @param rgb Packed RGB pixels, row-major (must stay valid while shown)
+     */
+    void show(int x, int y, int w, int h, const uint8_t* rgb);
+
+    /**
+     * Move the image without changing its pixels
+     * @param x Left column
+     * @param y Top row
+     */
+    void move(int x, int y);
+
+    /**
+     * Redraw on the next compose (the caller's image changed in place)
+     */
+    void invalidate();
+
+protected:
+    void render(FrameBuffer& fb) const;
+
+private:
+    std::vector<uint8_t> pixels_;     // Packed RGB image (set)
+    const uint8_t* image_;            // Image drawn: pixels_ or the caller's (nullptr = none)
+};
+
+/**
+ * Path node: individually colored pixels (e.g. the border snake)
+ */
+class PathNode : public SceneNode {
+public:
+    /**
+     * Set the pixels (no change = no damage)
+     * @param pixels Positions and colors
+     */
+    void set(const std::vector<std::pair<Point, RGBColor> >& pixels);
+
+protected:
+    void render(FrameBuffer& fb) const;
+
+private:
+    std::vector<std::pair<Point, RGBColor> > pixels_;  // Pixels in drawing order
+};
+
+/**
+ * Layer node: ordered group of child nodes (later children on top)
+ */
+class LayerNode : public SceneNode {
+public:
+    /**
+     * Destructor - deletes the children
+     */
+    ~LayerNode();
+
+    /**
+     * Append a child on top of the others
+     * @param node Node to add (takes ownership)
+     * @return node
+     */
+    SceneNode* add(SceneNode* node);
+
+    /**
+     * Number of children
+     * @return Child count
+     */
+    size_t size() const;
+
+    /**
+     * Child by index
+     * @param i Index (0 = bottom)
+     * @return Child node
+     */
+    SceneNode* child(size_t i) const;
+
+protected:
+    void render(FrameBuffer& fb) const;
+    void damage(std::vector<SceneRect>& damage) const;
+    void settle();
+    LayerNode* layer();
+
+private:
+    /**
+     * Recompute the bounds from the visible children (recursively, through
+     * the dirty child layers)
+     */
+    void updateBounds();
+
+    std::vector<SceneNode*> children_;  // Owned children, bottom to top
+
+    friend class Scene;
+};
+
+/**
+ * Time node: the time string drawn from a per-digit sprite cache
+ * One SpriteNode per character shows the cached image of its glyph (see
+ * DigitSprites), so a time tick damages and redraws only the digits that
+ * changed, each with a single blit. A string with any glyph that is not
+ * cached is drawn as one TextNode instead.
+ */
+class TimeNode : public LayerNode {
+public:
+    /**
+     * Constructor - nothing shown
+     */
+    TimeNode();
+
+    /**
+     * Set the time string and its style
+     * @param font Time font
+     * @param x Pen position (left edge)
+     * @param y Baseline
+     * @param color Text color
+     * @param text UTF-8 time string
+     */
+    void set(const BitmapFont& font, int x, int y, const RGBColor& color, const char* text);
+
+private:
+    DigitSprites sprites_;              // Glyph images in the current font and color
+    TextNode* text_;                    // Whole string when a glyph is not cached (owned by the layer)
+    std::vector<SpriteNode*> cells_;    // One node per character (owned by the layer, grown on demand)
+};
+
+/**
+ * Layout node: a layer of TextNodes mirroring a LayoutEngine Layout
+ * Runs are matched to text nodes by index, so a relayout that keeps the
+ * run count only damages the runs that moved or changed. The time run
+ * can be shown by a TimeNode (below the other runs) instead.
+ */
+class LayoutNode : public LayerNode {
+public:
+    /**
+     * Constructor - no runs
+     */
+    LayoutNode();
+
+    /**
+     * Show a layout
+     * @param layout Positioned text runs
+     * @param color Text color
+     * @param time_run Index of the run drawn from the digit sprite cache
+     *                 (LayoutEngine::timeRun(), -1 = none)
+     */
+    void set(const Layout& layout, const RGBColor& color, int time_run = -1);
+
+private:
+    TimeNode* time_;                    // Time run (owned by the layer, first child)
+    std::vector<TextNode*> runs_;       // One node per run (owned by the layer)
+};
+
+/**
+ * Retained Scene
+ * Owns the root layer and recomposes only damaged areas into a
+ * FrameBuffer: each damage rectangle is cleared to black and every visible
+ * node intersecting it is drawn again, clipped to it. A frame in which no
+ * node changed costs one walk over the dirty flags.
+ */
+class Scene {
+public:
+    /**
+     * Constructor - the first compose redraws the whole display
+     * @param width Display width
+     * @param height Display height
+     */
+    Scene(int width, int height);
+
+    /**
+     * Root layer (add nodes here)
+     * @return Root layer
+     */
+    LayerNode& root();
+
+    /**
+     * Recompose the whole display on the next compose (e.g. after
+     * something else drew into the framebuffer)
+     */
+    void invalidate();
+
+    /**
+     * Recompose the damaged areas
+     * @param fb Framebuffer holding the previously composed frame
+     * @return true if anything was redrawn
+     */
+    bool compose(FrameBuffer& fb);
+
+private:
+    /**
+     * Draw the visible nodes of a layer that intersect a rectangle
+     * @param layer Layer
+     * @param fb Framebuffer (clipped to rect)
+     * @param rect Damage rectangle
+     */
+    static void renderArea(const LayerNode& layer, FrameBuffer& fb, const SceneRect& rect);
+
+    LayerNode root_;                  // Root layer
+    int width_, height_;              // Display size
+    bool full_;                       // Next compose redraws everything
+    std::vector<SceneRect> damage_;   // Damage of the current compose (kept to avoid reallocation)
+};
+
+#endif // SCENE_H
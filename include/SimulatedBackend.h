@@ -0,0 +1,74 @@
+#ifndef SIMULATED_BACKEND_H
+#define SIMULATED_BACKEND_H
+
+#include "GPIOBackend.h"
+#include <string>
+#include <vector>
+
+/**
+ * Simulated GPIO Backend
+ * Replays a timestamped press/release script instead of touching hardware.
+ * Script format, one edge per line ('#' starts a comment):
+ *   <time_ms> press|release [pin]
+ * Times are relative to the start of the replay and must not decrease.
+ * Lines with a pin only drive that pin, so one script can describe several
+ * buttons or both channels of a rotary encoder; lines without apply to all.
+ *
+ * Real-time mode follows CLOCK_MONOTONIC from setup(), so the clock can be
+ * driven by a script on any machine. Virtual mode only advances through
+ * advanceTo(), letting tests and benchmarks replay sessions through the
+ * gesture state machine faster than real time.
+ */
+class SimulatedBackend : public GPIOBackend {
+public:
+    /**
+     * Constructor
+     * @param script_path Path to the press/release script
+     * @param realtime true to follow the monotonic clock, false for advanceTo()
+     * @param pin Pin this backend simulates (-1 = ignore pin filters)
+     */
+    SimulatedBackend(const std::string& script_path, bool realtime = true, int pin = -1);
+
+    /**
+     * Load the script (returns false if it cannot be read or parsed)
+     */
+    bool setup();
+    int read();
+    bool readEdge(GPIOEdge& edge);
+    const char* name() const { return "sim"; }
+
+    /**
+     * Advance the virtual clock (virtual mode only)
+     * @param now_ms Script time in milliseconds
+     */
+    void advanceTo(long now_ms);
+
+    /**
+     * Script time of the next edge not yet returned by readEdge()
+     * @return Time in ms, or -1 if the script is exhausted
+     */
+    long nextEdgeTime() const;
+
+    /**
+     * Timestamp of the last scripted edge
+     * @return Time in ms (0 for an empty script)
+     */
+    long endTime() const;
+
+private:
+    /**
+     * Current time on the script clock
+     * @return Milliseconds since replay start (real-time mode) or virtual time
+     */
+    long now() const;
+
+    std::string script_path_;       // Script file path
+    bool realtime_;                 // Follow CLOCK_MONOTONIC instead of advanceTo()
+    int pin_;                       // Simulated pin for per-pin script lines (-1 = any)
+    long base_ms_;                  // Monotonic time at setup() (real-time mode)
+    long virtual_ms_;               // Current virtual time (virtual mode)
+    std::vector<GPIOEdge> script_;  // Parsed edges (time relative to replay start)
+    size_t next_;                   // Next edge to return from readEdge()
+};
+
+#endif // SIMULATED_BACKEND_H
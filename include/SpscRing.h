@@ -0,0 +1,66 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Bounded Single-Producer/Single-Consumer Ring Buffer
+ * Lock-free queue for handing events from one thread to another.
+ * push() must only be called from the producer thread and pop() only
+ * from the consumer thread; neither call ever blocks.
+ * @tparam T Element type (copied in and out)
+ * @tparam N Capacity, must be a power of two
+ */
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    /**
+     * Constructor - initializes an empty ring
+     */
+    SpscRing() : head_(0), tail_(0) {}
+
+    /**
+     * Append an element (producer thread only)
+     * @param item Element to copy into the ring
+     * @return true if queued, false if the ring is full
+     */
+    bool push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= N) return false;
+        items_[tail & (N - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest element (consumer thread only)
+     * @param item Output for the dequeued element
+     * @return true if an element was dequeued, false if the ring is empty
+     */
+    bool pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        item = items_[head & (N - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Check if the ring is empty (approximate when called concurrently)
+     * @return true if no elements are queued
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    T items_[N];                                        // Element storage
+    std::atomic<size_t> head_;                          // Next slot to read (written by consumer)
+    char pad_[64 - sizeof(std::atomic<size_t>)];        // Keep head_/tail_ on separate cache lines
+    std::atomic<size_t> tail_;                          // Next slot to write (written by producer)
+};
+
+#endif // SPSC_RING_H
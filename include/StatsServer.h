@@ -0,0 +1,59 @@
+#ifndef STATS_SERVER_H
+#define STATS_SERVER_H
+
+#include "FrameStats.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+#define STATS_TABLE_SIZE 4096               // Largest report served (bytes)
+
+/**
+ * Frame Statistics Socket
+ * Serves FrameStats::report() on a local Unix stream socket: every
+ * connection gets the current per-stage table and is closed, e.g.
+ *   socat - UNIX-CONNECT:/run/led-clock/stats.sock
+ * The socket's directory is created if missing and a stale socket file
+ * is replaced. Connections are handled one at a time on a background
+ * thread, so a client never touches the logic or render thread.
+ */
+class StatsServer {
+public:
+    /**
+     * Constructor - not listening until start()
+     * @param stats Statistics to serve (must outlive the server)
+     * @param path Socket path
+     */
+    StatsServer(const FrameStats& stats, const std::string& path);
+
+    /**
+     * Destructor - stops the server and removes the socket
+     */
+    ~StatsServer();
+
+    /**
+     * Bind the socket and start the server thread
+     * @return true if listening
+     */
+    bool start();
+
+    /**
+     * Stop and join the server thread and remove the socket (no-op if not running)
+     */
+    void stop();
+
+private:
+    /**
+     * Server thread body: answer connections until stop()
+     */
+    void threadLoop();
+
+    const FrameStats& stats_;       // Served statistics
+    std::string path_;              // Socket path
+    int listen_fd_;                 // Listening socket (-1 = not running)
+    int wake_fd_;                   // eventfd: stop requested
+    std::thread thread_;            // Server thread
+    std::atomic<bool> stopping_;    // Asks the thread to exit
+};
+
+#endif // STATS_SERVER_H
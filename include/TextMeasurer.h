@@ -0,0 +1,94 @@
+#ifndef TEXT_MEASURER_H
+#define TEXT_MEASURER_H
+
+#include "BitmapFont.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+/**
+ * Text Width Measurement
+ * Computes the width DrawText() would return from cached per-glyph advance
+ * widths (BitmapFont::characterWidth) without writing any pixels. Missing glyphs
+ * measure as U+FFFD, matching the library's glyph fallback. Strings are
+ * not memoized: summing cached advances is cheaper than hashing the text.
+ */
+class TextMeasurer {
+public:
+    /**
+     * Constructor - empty caches
+     */
+    TextMeasurer();
+
+    /**
+     * Destructor - frees the font caches
+     */
+    ~TextMeasurer();
+
+    /**
+     * Width of a UTF-8 string (no allocation once the glyphs are cached)
+     * @param font Font the text will be drawn with
+     * @param utf8_text NUL-terminated UTF-8 text
+     * @return Width in pixels, as returned by DrawText()
+     */
+    int width(const BitmapFont& font, const char* utf8_text);
+
+    /**
+     * Width of a UTF-8 byte range (no allocation once the glyphs are cached)
+     * @param font Font the text will be drawn with
+     * @param utf8_text Start of the UTF-8 text
+     * @param length Length in bytes
+     * @return Width in pixels
+     */
+    int width(const BitmapFont& font, const char* utf8_text, size_t length);
+
+    /**
+     * Advance width of one code point
+     * @param font Font to measure with
+     * @param codepoint Unicode code point
+     * @return Advance in pixels (replacement glyph if missing, 0 if neither exists)
+     */
+    int advance(const BitmapFont& font, uint32_t codepoint);
+
+    /**
+     * Drop all cached advances (e.g., after reloading a font)
+     */
+    void clear();
+
+private:
+    /** Cached metrics of one font */
+    struct FontCache {
+        const BitmapFont* font;                       // Font the metrics belong to
+        int ascii[128];                               // ASCII advances (-1 = not looked up yet)
+        std::map<uint32_t, int> other;                // Non-ASCII advances
+    };
+
+    /**
+     * Find or create the cache of a font
+     * @param font Font
+     * @return Cache entry
+     */
+    FontCache& cacheFor(const BitmapFont& font);
+
+    /**
+     * Advance of a code point using a font's cache
+     * @param cache Font cache
+     * @param codepoint Unicode code point
+     * @return Advance in pixels
+     */
+    int advance(FontCache& cache, uint32_t codepoint);
+
+    /**
+     * Sum the advances of a UTF-8 byte range
+     * @param cache Font cache
+     * @param text Start of the UTF-8 text
+     * @param end End of the range
+     * @return Width in pixels
+     */
+    int measure(FontCache& cache, const char* text, const char* end);
+
+    std::vector<FontCache*> fonts_;  // One cache per font (a handful of fonts at most)
+};
+
+#endif // TEXT_MEASURER_H
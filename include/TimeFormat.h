@@ -0,0 +1,130 @@
+#ifndef TIME_FORMAT_H
+#define TIME_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#define TIME_FORMAT_MAX 64                  // Maximum formatted length (bytes, including NUL)
+#define TIME_TOKEN_MAX 32                   // Maximum length of one token's text (bytes, including NUL)
+
+/**
+ * Compiled strftime Format
+ * Parses a strftime format once into a token program: literal runs,
+ * numeric fields rendered directly (%H %I %k %l %M %S %d %e %m %y %Y %j
+ * %u %w, with the glibc '-', '_' and '0' flags), composites expanded into
+ * their fields (%T %R %D %F), and single-conversion strftime calls for
+ * everything locale-dependent (%a %b %p, ...).
+ *
+ * Every token carries its change period (second, minute, hour, day). On
+ * update() a token is re-rendered only if the time crossed its period
+ * boundary since the last tick, and the output string is rebuilt only when
+ * some token's text actually changed.
+ */
+class TimeFormat {
+public:
+    /** Change period of a token */
+    enum Period {
+        PERIOD_SECOND,  // Changes every second
+        PERIOD_MINUTE,  // Changes every minute
+        PERIOD_HOUR,    // Changes every hour (or with the UTC offset)
+        PERIOD_DAY,     // Changes at midnight (day, month, year fields)
+        PERIOD_NEVER    // Literal text
+    };
+
+    /**
+     * Constructor - compiles the format
+     * @param format strftime format string
+     * @param uppercase Convert the output to uppercase (as the date display does)
+     */
+    explicit TimeFormat(const std::string& format, bool uppercase = false);
+
+    /**
+     * Bring the output up to date with a broken-down time
+     * @param tm Local time
+     * @return true if the output text changed
+     */
+    bool update(const struct tm& tm);
+
+    /**
+     * Formatted text of the last update()
+     * @return NUL-terminated text (empty before the first update)
+     */
+    const char* text() const;
+
+    /**
+     * Shortest change period of the format
+     * @return Period in seconds: 1, 60, 3600 or 86400 (0 if the text never changes)
+     */
+    int period() const;
+
+private:
+    /** Kind of token */
+    enum Kind {
+        LITERAL,        // Fixed text
+        NUMBER,         // Numeric field rendered directly
+        STRFTIME        // One conversion rendered with strftime
+    };
+
+    /** One instruction of the program */
+    struct Token {
+        Kind kind;                  // How the token is rendered
+        Period period;              // When it can change
+        char conversion;            // Conversion character (NUMBER)
+        char pad;                   // Padding: '0', ' ' or 0 for none (NUMBER)
+        char spec[8];               // Conversion spec with flags (STRFTIME)
+        int64_t key;                // Period key of the rendered text (-1 = never rendered)
+        char text[TIME_TOKEN_MAX];  // Rendered text
+        size_t length;              // Length of text
+    };
+
+    /**
+     * Compile a format into tokens_
+     * @param format strftime format
+     */
+    void compile(const std::string& format);
+
+    /**
+     * Append literal text (split into TIME_TOKEN_MAX chunks)
+     * @param text Literal text
+     * @param length Length in bytes
+     */
+    void addLiteral(const char* text, size_t length);
+
+    /**
+     * Append a numeric field
+     * @param conversion Conversion character
+     * @param pad Padding flag ('-', '_', '0' or 0 for the default)
+     */
+    void addNumber(char conversion, char pad);
+
+    /**
+     * Append a strftime conversion
+     * @param spec Conversion spec including '%' and flags
+     * @param period Change period
+     */
+    void addStrftime(const std::string& spec, Period period);
+
+    /**
+     * Render one token
+     * @param token Token
+     * @param tm Local time
+     */
+    void render(Token& token, const struct tm& tm) const;
+
+    /**
+     * Key identifying the period a time falls in
+     * @param period Period
+     * @param tm Local time
+     * @return Key that changes exactly when the period boundary is crossed
+     */
+    static int64_t periodKey(Period period, const struct tm& tm);
+
+    std::vector<Token> tokens_;     // Compiled program
+    bool uppercase_;                // Uppercase the output
+    char text_[TIME_FORMAT_MAX];    // Output text
+};
+
+#endif // TIME_FORMAT_H
@@ -0,0 +1,73 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+/**
+ * Lock-Free Triple Buffer
+ * Hands the latest value from one producer thread to one consumer thread.
+ * The producer fills back() and publish()es it; the consumer update()s to
+ * the most recently published value and reads front(). Neither side ever
+ * waits for the other: the producer always has a free slot, and values
+ * published faster than they are consumed are replaced, not queued.
+ * Slots are reused, so the producer must set every field it relies on.
+ * @tparam T Value type
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * Constructor - front, middle and back slots, nothing published
+     */
+    TripleBuffer() : front_(0), middle_(1), back_(2) {}
+
+    /**
+     * Slot the producer fills next (producer thread only)
+     * @return Back slot
+     */
+    T& back() {
+        return slots_[back_];
+    }
+
+    /**
+     * Publish the back slot (producer thread only)
+     * @return true if a value the consumer had not taken yet was replaced
+     */
+    bool publish() {
+        unsigned previous = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+        back_ = previous & INDEX;
+        return (previous & FRESH) != 0;
+    }
+
+    /**
+     * Take the latest published value, if any (consumer thread only)
+     * @return true if front() changed
+     */
+    bool update() {
+        if ((middle_.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        unsigned previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & INDEX;
+        return true;
+    }
+
+    /**
+     * Latest value taken by update() (consumer thread only)
+     * @return Front slot
+     */
+    const T& front() const {
+        return slots_[front_];
+    }
+
+private:
+    static const unsigned INDEX = 3;    // Slot index bits of middle_
+    static const unsigned FRESH = 4;    // middle_ holds a value not yet taken
+
+    T slots_[3];                                        // Value storage
+    unsigned front_;                                    // Slot read by the consumer
+    char pad_[64 - sizeof(unsigned)];                   // Keep the consumer and producer indices apart
+    std::atomic<unsigned> middle_;                      // Slot in transit (| FRESH once published)
+    char pad2_[64 - sizeof(std::atomic<unsigned>)];
+    unsigned back_;                                     // Slot written by the producer
+};
+
+#endif // TRIPLE_BUFFER_H
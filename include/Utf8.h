@@ -0,0 +1,32 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <stdint.h>
+
+/**
+ * Decode one UTF-8 sequence the way the library's DrawText() does
+ * Stray continuation or invalid lead bytes decode as their byte value.
+ * @param it Current position, advanced past the sequence
+ * @param end End of the text (a truncated sequence stops here)
+ * @return Unicode code point
+ */
+inline uint32_t utf8NextCodepoint(const char*& it, const char* end) {
+    uint32_t cp = static_cast<uint8_t>(*it++);
+    int continuation = 0;
+    if ((cp & 0xE0) == 0xC0) {
+        cp &= 0x1F;
+        continuation = 1;
+    } else if ((cp & 0xF0) == 0xE0) {
+        cp &= 0x0F;
+        continuation = 2;
+    } else if ((cp & 0xF8) == 0xF0) {
+        cp &= 0x07;
+        continuation = 3;
+    }
+    for (; continuation > 0 && it < end; continuation--) {
+        cp = (cp << 6) | (static_cast<uint8_t>(*it++) & 0x3F);
+    }
+    return cp;
+}
+
+#endif // UTF8_H
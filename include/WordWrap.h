@@ -0,0 +1,117 @@
+#ifndef WORD_WRAP_H
+#define WORD_WRAP_H
+
+#include "BitmapFont.h"
+#include "TextMeasurer.h"
+#include <stddef.h>
+
+#define WRAP_MAX_WORDS 32                   // Words considered by the wrapper (the rest stays on the last line)
+#define WRAP_MAX_LINES 8                    // Lines produced at most
+
+/**
+ * Wrapped line: a byte range of the source text
+ */
+struct WrapLine {
+    size_t offset;  // First byte in the source text
+    size_t length;  // Length in bytes (no leading/trailing spaces)
+    int width;      // Width in pixels
+};
+
+/**
+ * Allocation-Free Word Wrap
+ * Splits text on spaces into lines no wider than a given width, working on
+ * fixed arrays of word ranges and line ranges into the caller's text. Word
+ * widths are accumulated from cached glyph advances in a single pass; line
+ * widths are sums of word widths plus spaces, so no candidate string is
+ * ever built or re-measured.
+ *
+ * Greedy fills each line as far as it goes (fewest lines). Balanced keeps
+ * the greedy line count but minimizes the sum of squared slack over all
+ * lines (minimum raggedness), which suits centered text.
+ * A single word wider than the limit gets a line of its own.
+ */
+class WordWrap {
+public:
+    /** Line breaking strategy */
+    enum Mode {
+        GREEDY,     // First fit
+        BALANCED    // Minimum raggedness with the greedy line count
+    };
+
+    /**
+     * Constructor - no lines
+     */
+    WordWrap();
+
+    /**
+     * Wrap a text
+     * @param measurer Glyph advance cache
+     * @param font Font the text will be drawn with
+     * @param text NUL-terminated UTF-8 text (must outlive the lines)
+     * @param max_width Maximum line width in pixels
+     * @param mode Line breaking strategy
+     * @return Number of lines
+     */
+    int wrap(TextMeasurer& measurer, const BitmapFont& font, const char* text, int max_width, Mode mode);
+
+    /**
+     * Number of lines of the last wrap()
+     * @return Line count
+     */
+    int lineCount() const;
+
+    /**
+     * Line of the last wrap()
+     * @param i Line index (0 to lineCount() - 1)
+     * @return Line range
+     */
+    const WrapLine& line(int i) const;
+
+    /**
+     * Parse a mode name from the config
+     * @param name "greedy" or "balanced"
+     * @return Mode (GREEDY for unknown names)
+     */
+    static Mode parseMode(const char* name);
+
+private:
+    /**
+     * Width of words [first, last] on one line
+     * @param first First word
+     * @param last Last word
+     * @return Width in pixels including the spaces between words
+     */
+    int span(int first, int last) const;
+
+    /**
+     * Break after the words that fit, first fit
+     * @param max_width Maximum line width
+     */
+    void breakGreedy(int max_width);
+
+    /**
+     * Break into lines_ lines with minimum sum of squared slack
+     * @param max_width Maximum line width
+     */
+    void breakBalanced(int max_width);
+
+    /**
+     * Build lines_ from the last word of each line
+     * @param ends Index of the last word of each line
+     * @param count Number of lines
+     */
+    void setLines(const int* ends, int count);
+
+    // Words of the current text
+    size_t word_offset_[WRAP_MAX_WORDS];    // First byte of each word
+    size_t word_end_[WRAP_MAX_WORDS];       // One past the last byte of each word
+    int word_width_[WRAP_MAX_WORDS];        // Width of each word
+    int words_;                             // Number of words
+    int space_width_;                       // Width of a space
+
+    // Result
+    WrapLine lines_[WRAP_MAX_LINES];        // Lines of the last wrap()
+    int line_count_;                        // Number of lines
+};
+
+#endif // WORD_WRAP_H
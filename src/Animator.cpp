@@ -53,3 +53,40 @@ RGBColor Animator::interpolateColor(const RGBColor& from, const RGBColor& to, do
     result.b = static_cast<uint8_t>(from.b * (1 - t) + to.b * t);
     return result;
 }
+
+RGBColor Animator::rotateHue(const RGBColor& color, int degrees) {
+    degrees %= 360;
+    if (degrees < 0) degrees += 360;
+    if (degrees == 0) return color;
+
+    // RGB -> HSV
+    int maxc = std::max(color.r, std::max(color.g, color.b));
+    int minc = std::min(color.r, std::min(color.g, color.b));
+    int delta = maxc - minc;
+    if (delta == 0) return color; // Grey has no hue
+
+    double hue;
+    if (maxc == color.r) {
+        hue = 60.0 * std::fmod((color.g - color.b) / static_cast<double>(delta), 6.0);
+    } else if (maxc == color.g) {
+        hue = 60.0 * ((color.b - color.r) / static_cast<double>(delta) + 2.0);
+    } else {
+        hue = 60.0 * ((color.r - color.g) / static_cast<double>(delta) + 4.0);
+    }
+    hue = std::fmod(hue + degrees + 360.0, 360.0);
+
+    // HSV -> RGB with the same value and chroma
+    double x = delta * (1.0 - std::fabs(std::fmod(hue / 60.0, 2.0) - 1.0));
+    double r = 0, g = 0, b = 0;
+    switch (static_cast<int>(hue / 60.0)) {
+        case 0: r = delta; g = x; break;
+        case 1: r = x; g = delta; break;
+        case 2: g = delta; b = x; break;
+        case 3: g = x; b = delta; break;
+        case 4: r = x; b = delta; break;
+        default: r = delta; b = x; break;
+    }
+    return RGBColor(static_cast<uint8_t>(r + minc + 0.5),
+                    static_cast<uint8_t>(g + minc + 0.5),
+                    static_cast<uint8_t>(b + minc + 0.5));
+}
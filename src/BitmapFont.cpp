@@ -0,0 +1,130 @@
+#include "BitmapFont.h"
+#include <cstdio>
+#include <cstring>
+
+// Value of one hex digit (-1 if not a hex digit)
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+BitmapFont::BitmapFont() : height_(0), baseline_(0) {
+    for (int i = 0; i < 128; i++) ascii_[i] = -1;
+}
+
+bool BitmapFont::load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    glyphs_.clear();
+    spans_.clear();
+    other_.clear();
+    for (int i = 0; i < 128; i++) ascii_[i] = -1;
+    height_ = baseline_ = 0;
+
+    // Current glyph while parsing
+    int codepoint = -1;
+    int advance = 0;
+    int bbx_w = 0, bbx_h = 0, bbx_x = 0, bbx_y = 0;
+    int row = -1;
+    Glyph glyph = Glyph();
+
+    char line[1024];
+    while (fgets(line, sizeof(line), f)) {
+        if (row >= 0 && row < bbx_h) {
+            // One bitmap row, MSB first; collect runs of set bits
+            int digits = strspn(line, "0123456789abcdefABCDEF");
+            int y = row - bbx_h - bbx_y;
+            int run_start = -1;
+            for (int bit = 0; bit <= bbx_w; bit++) {
+                int digit = bit < bbx_w && bit / 4 < digits ? hexValue(line[bit / 4]) : 0;
+                bool lit = (digit & (8 >> (bit % 4))) != 0;
+
+                // Pixels outside [0, advance) are clipped like DrawGlyph()
+                int x = bbx_x + bit;
+                lit = lit && x >= 0 && x < advance;
+                if (lit && run_start < 0) run_start = x;
+                if (!lit && run_start >= 0) {
+                    GlyphSpan span;
+                    span.x = run_start;
+                    span.y = y;
+                    span.length = x - run_start;
+                    spans_.push_back(span);
+                    glyph.span_count++;
+                    run_start = -1;
+                }
+            }
+            row++;
+            continue;
+        }
+
+        int fbb_w, fbb_h, fbb_x, fbb_y;
+        if (sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &fbb_w, &fbb_h, &fbb_x, &fbb_y) == 4) {
+            height_ = fbb_h;
+            baseline_ = fbb_h + fbb_y;
+        } else if (strncmp(line, "STARTCHAR", 9) == 0) {
+            codepoint = -1;
+            advance = 0;
+            bbx_w = bbx_h = bbx_x = bbx_y = 0;
+            row = -1;
+        } else if (sscanf(line, "ENCODING %d", &codepoint) == 1) {
+            // codepoint set by sscanf
+        } else if (sscanf(line, "DWIDTH %d", &advance) == 1) {
+            // advance set by sscanf
+        } else if (sscanf(line, "BBX %d %d %d %d", &bbx_w, &bbx_h, &bbx_x, &bbx_y) == 4) {
+            // box set by sscanf
+        } else if (strncmp(line, "BITMAP", 6) == 0) {
+            row = 0;
+            glyph.advance = advance;
+            glyph.first_span = spans_.size();
+            glyph.span_count = 0;
+        } else if (strncmp(line, "ENDCHAR", 7) == 0) {
+            if (row >= 0 && codepoint >= 0) {
+                int index = glyphs_.size();
+                glyphs_.push_back(glyph);
+                if (codepoint < 128) {
+                    ascii_[codepoint] = index;
+                } else {
+                    other_[codepoint] = index;
+                }
+            } else if (row >= 0) {
+                spans_.resize(glyph.first_span); // Unencoded glyph: drop its spans
+            }
+            row = -1;
+        }
+    }
+    fclose(f);
+    return !glyphs_.empty();
+}
+
+int BitmapFont::height() const {
+    return height_;
+}
+
+int BitmapFont::baseline() const {
+    return baseline_;
+}
+
+int BitmapFont::characterWidth(uint32_t codepoint) const {
+    const Glyph* g = find(codepoint);
+    return g ? g->advance : -1;
+}
+
+const Glyph* BitmapFont::glyph(uint32_t codepoint) const {
+    const Glyph* g = find(codepoint);
+    return g ? g : find(REPLACEMENT_CODEPOINT);
+}
+
+const GlyphSpan* BitmapFont::spans() const {
+    return spans_.empty() ? nullptr : &spans_[0];
+}
+
+const Glyph* BitmapFont::find(uint32_t codepoint) const {
+    if (codepoint < 128) {
+        return ascii_[codepoint] >= 0 ? &glyphs_[ascii_[codepoint]] : nullptr;
+    }
+    std::map<uint32_t, int>::const_iterator it = other_.find(codepoint);
+    return it != other_.end() ? &glyphs_[it->second] : nullptr;
+}
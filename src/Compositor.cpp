@@ -0,0 +1,128 @@
+#include "Compositor.h"
+#include "Utf8.h"
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COMPOSITOR_NEON 1
+#endif
+
+// x / 255 rounded, for x = v + 128 with v in [0, 255 * 255]
+static inline unsigned div255(unsigned x) {
+    return (x + (x >> 8)) >> 8;
+}
+
+#ifdef COMPOSITOR_NEON
+// Same rounding as div255() on eight 16-bit lanes, narrowed to bytes
+static inline uint8x8_t div255x8(uint16x8_t x) {
+    return vshrn_n_u16(vsraq_n_u16(x, x, 8), 8);
+}
+#endif
+
+Compositor::Compositor(int width, int height)
+    : width_(width), height_(height), frame_(width * height * 3, 0) {}
+
+int Compositor::addLayer() {
+    Layer layer;
+    layer.rgba.assign(width_ * height_ * 4, 0);
+    layer.opacity = 255;
+    layer.empty = true;
+    layers_.push_back(layer);
+    return static_cast<int>(layers_.size()) - 1;
+}
+
+void Compositor::clear(int layer, const RGBColor& color, uint8_t alpha) {
+    Layer& l = layers_[layer];
+    uint8_t* p = &l.rgba[0];
+    for (int i = 0; i < width_ * height_; i++, p += 4) {
+        p[0] = color.r;
+        p[1] = color.g;
+        p[2] = color.b;
+        p[3] = alpha;
+    }
+    l.empty = alpha == 0;
+}
+
+void Compositor::setPixel(int layer, int x, int y, const RGBColor& color, uint8_t alpha) {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) return;
+
+    Layer& l = layers_[layer];
+    uint8_t* p = &l.rgba[(y * width_ + x) * 4];
+    p[0] = color.r;
+    p[1] = color.g;
+    p[2] = color.b;
+    p[3] = alpha;
+    if (alpha != 0) l.empty = false;
+}
+
+void Compositor::drawText(int layer, const BitmapFont& font, int x, int y, const RGBColor& color, const char* utf8_text) {
+    const char* end = utf8_text + strlen(utf8_text);
+    int pen = x;
+    while (utf8_text < end) {
+        const Glyph* g = font.glyph(utf8NextCodepoint(utf8_text, end));
+        if (!g) continue;
+
+        const GlyphSpan* span = font.spans() + g->first_span;
+        for (uint32_t i = 0; i < g->span_count; i++, span++) {
+            for (int k = 0; k < span->length; k++) {
+                setPixel(layer, pen + span->x + k, y + span->y, color);
+            }
+        }
+        pen += g->advance;
+    }
+}
+
+void Compositor::setOpacity(int layer, uint8_t opacity) {
+    layers_[layer].opacity = opacity;
+}
+
+uint8_t Compositor::opacity(int layer) const {
+    return layers_[layer].opacity;
+}
+
+void Compositor::composite(const uint8_t* base_rgb, FrameBuffer& out) {
+    memcpy(&frame_[0], base_rgb, frame_.size());
+    for (size_t i = 0; i < layers_.size(); i++) {
+        const Layer& l = layers_[i];
+        if (l.empty || l.opacity == 0) continue;
+        blendRow(&frame_[0], &l.rgba[0], width_ * height_, l.opacity);
+    }
+    out.assign(&frame_[0]);
+}
+
+void Compositor::blendRow(uint8_t* dst_rgb, const uint8_t* src_rgba, int count, uint8_t opacity) {
+    int i = 0;
+#ifdef COMPOSITOR_NEON
+    // 16 pixels per iteration: deinterleave, blend per channel in 16 bits
+    const uint8x8_t op = vdup_n_u8(opacity);
+    const uint16x8_t half = vdupq_n_u16(128);
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t s = vld4q_u8(src_rgba + i * 4);
+        uint8x16x3_t d = vld3q_u8(dst_rgb + i * 3);
+
+        uint8x8_t a_lo = div255x8(vmlal_u8(half, vget_low_u8(s.val[3]), op));
+        uint8x8_t a_hi = div255x8(vmlal_u8(half, vget_high_u8(s.val[3]), op));
+        uint8x8_t ia_lo = vmvn_u8(a_lo);   // 255 - a
+        uint8x8_t ia_hi = vmvn_u8(a_hi);
+
+        for (int c = 0; c < 3; c++) {
+            uint16x8_t lo = vmlal_u8(vmlal_u8(half, vget_low_u8(s.val[c]), a_lo), vget_low_u8(d.val[c]), ia_lo);
+            uint16x8_t hi = vmlal_u8(vmlal_u8(half, vget_high_u8(s.val[c]), a_hi), vget_high_u8(d.val[c]), ia_hi);
+            d.val[c] = vcombine_u8(div255x8(lo), div255x8(hi));
+        }
+        vst3q_u8(dst_rgb + i * 3, d);
+    }
+#endif
+    // Scalar: the remaining pixels, or all of them without NEON
+    const uint8_t* s = src_rgba + i * 4;
+    uint8_t* d = dst_rgb + i * 3;
+    for (; i < count; i++, s += 4, d += 3) {
+        unsigned a = div255(s[3] * opacity + 128);
+        if (a == 0) continue;
+
+        unsigned ia = 255 - a;
+        d[0] = static_cast<uint8_t>(div255(s[0] * a + d[0] * ia + 128));
+        d[1] = static_cast<uint8_t>(div255(s[1] * a + d[1] * ia + 128));
+        d[2] = static_cast<uint8_t>(div255(s[2] * a + d[2] * ia + 128));
+    }
+}
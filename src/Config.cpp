@@ -6,12 +6,15 @@
 using json = nlohmann::json;
 
 Config::Config() : brightness(50), fixed_color(-1), colorTransitionEnabled(true),
-                   colorTransitionIntervalMinutes(2), colorTransitionDurationMs(1000),
+                   colorTransitionIntervalMinutes(2), colorTransitionDurationMs(1000), hueShift(0),
                    dateFormat("%a %d %b"), timeFormat("%H:%M:%S"),
                    showDate(true), showTime(true),
                    dateFont("5x8.bdf"), timeFont("7x14B.bdf"),
                    dateIgnoreDescenders(true), timeIgnoreDescenders(true),
-                   dateTimeSpacing(1) {
+                   dateTimeSpacing(1), dateWrap("greedy"), buttonBackend("gpiochip"),
+                   gestureDebounceMs(80), gestureLongPressMs(1000), gestureMultiTapMs(300), gestureRepeatIntervalMs(250),
+                   encoderEnabled(false), encoderPinA(5), encoderPinB(6), encoderStepsPerDetent(4),
+                   encoderFunction("brightness"), encoderStep(2) {
     // Default: 2 minutes interval, 1 second transition
     colors = {
         {"GIALLO", 255, 220, 0},
@@ -20,6 +23,9 @@ Config::Config() : brightness(50), fixed_color(-1), colorTransitionEnabled(true)
         {"BLU", 0, 0, 255},
         {"BIANCO", 255, 255, 255}
     };
+    buttons = {
+        {"main", GPIO_NUM}
+    };
 }
 
 bool Config::load(const char* path) {
@@ -63,6 +69,11 @@ bool Config::load(const char* path) {
             }
         }
 
+        if (j.contains("hueShift")) {
+            int shift = j["hueShift"];
+            hueShift = (shift % 360 + 360) % 360;
+        }
+
         // Load date and time formats
         if (j.contains("dateFormat")) dateFormat = j["dateFormat"];
         if (j.contains("timeFormat")) timeFormat = j["timeFormat"];
@@ -75,6 +86,37 @@ bool Config::load(const char* path) {
         if (j.contains("dateIgnoreDescenders")) dateIgnoreDescenders = j["dateIgnoreDescenders"];
         if (j.contains("timeIgnoreDescenders")) timeIgnoreDescenders = j["timeIgnoreDescenders"];
         if (j.contains("dateTimeSpacing")) dateTimeSpacing = j["dateTimeSpacing"];
+        if (j.contains("dateWrap")) dateWrap = j["dateWrap"];
+
+        // Load input options
+        if (j.contains("buttonBackend")) buttonBackend = j["buttonBackend"];
+        if (j.contains("buttons") && j["buttons"].is_array()) {
+            buttons.clear();
+            for (const auto& button : j["buttons"]) {
+                ButtonConfig bc;
+                bc.name = button["name"];
+                bc.pin = button["pin"];
+                buttons.push_back(bc);
+            }
+        }
+
+        // Load gesture timing
+        if (j.contains("gestures")) {
+            if (j["gestures"].contains("debounceMs")) gestureDebounceMs = j["gestures"]["debounceMs"];
+            if (j["gestures"].contains("longPressMs")) gestureLongPressMs = j["gestures"]["longPressMs"];
+            if (j["gestures"].contains("multiTapMs")) gestureMultiTapMs = j["gestures"]["multiTapMs"];
+            if (j["gestures"].contains("repeatIntervalMs")) gestureRepeatIntervalMs = j["gestures"]["repeatIntervalMs"];
+        }
+
+        // Load encoder
+        if (j.contains("encoder")) {
+            if (j["encoder"].contains("enabled")) encoderEnabled = j["encoder"]["enabled"];
+            if (j["encoder"].contains("pinA")) encoderPinA = j["encoder"]["pinA"];
+            if (j["encoder"].contains("pinB")) encoderPinB = j["encoder"]["pinB"];
+            if (j["encoder"].contains("stepsPerDetent")) encoderStepsPerDetent = j["encoder"]["stepsPerDetent"];
+            if (j["encoder"].contains("function")) encoderFunction = j["encoder"]["function"];
+            if (j["encoder"].contains("step")) encoderStep = j["encoder"]["step"];
+        }
 
         // Validation: at least one of date or time must be shown
         if (!showDate && !showTime) {
@@ -110,6 +152,7 @@ bool Config::save(const char* path) {
         j["colorTransition"]["enabled"] = colorTransitionEnabled;
         j["colorTransition"]["intervalMinutes"] = colorTransitionIntervalMinutes;
         j["colorTransition"]["durationMs"] = colorTransitionDurationMs;
+        j["hueShift"] = hueShift;
 
         // Save date and time formats
         j["dateFormat"] = dateFormat;
@@ -123,6 +166,31 @@ bool Config::save(const char* path) {
         j["dateIgnoreDescenders"] = dateIgnoreDescenders;
         j["timeIgnoreDescenders"] = timeIgnoreDescenders;
         j["dateTimeSpacing"] = dateTimeSpacing;
+        j["dateWrap"] = dateWrap;
+
+        // Save input options
+        j["buttonBackend"] = buttonBackend;
+        j["buttons"] = json::array();
+        for (const auto& bc : buttons) {
+            json button;
+            button["name"] = bc.name;
+            button["pin"] = bc.pin;
+            j["buttons"].push_back(button);
+        }
+
+        // Save gesture timing
+        j["gestures"]["debounceMs"] = gestureDebounceMs;
+        j["gestures"]["longPressMs"] = gestureLongPressMs;
+        j["gestures"]["multiTapMs"] = gestureMultiTapMs;
+        j["gestures"]["repeatIntervalMs"] = gestureRepeatIntervalMs;
+
+        // Save encoder
+        j["encoder"]["enabled"] = encoderEnabled;
+        j["encoder"]["pinA"] = encoderPinA;
+        j["encoder"]["pinB"] = encoderPinB;
+        j["encoder"]["stepsPerDetent"] = encoderStepsPerDetent;
+        j["encoder"]["function"] = encoderFunction;
+        j["encoder"]["step"] = encoderStep;
 
         // Write to file
         std::ofstream file(path);
@@ -0,0 +1,68 @@
+#include "ConfigSaver.h"
+#include <cstdio>
+#include <system_error>
+#include <utility>
+
+ConfigSaver::ConfigSaver(const std::string& path)
+    : path_(path), has_pending_(false), stopping_(false), running_(false) {}
+
+ConfigSaver::~ConfigSaver() {
+    stop();
+}
+
+bool ConfigSaver::start() {
+    if (running_) return true;
+
+    stopping_ = false;
+    try {
+        thread_ = std::thread(&ConfigSaver::threadLoop, this);
+    } catch (const std::system_error& e) {
+        fprintf(stderr, "Failed to start config writer thread: %s\n", e.what());
+        return false;
+    }
+    running_ = true;
+    return true;
+}
+
+void ConfigSaver::stop() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    running_ = false;
+}
+
+void ConfigSaver::request(const Config& config) {
+    if (!running_) {
+        // No writer thread: save on the caller's thread
+        Config snapshot = config;
+        snapshot.save(path_.c_str());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        pending_ = config;
+        has_pending_ = true;
+    }
+    wake_.notify_one();
+}
+
+void ConfigSaver::threadLoop() {
+    Config snapshot;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(lock_);
+            wake_.wait(lock, [this]() { return has_pending_ || stopping_; });
+            if (!has_pending_) return; // Stopping with nothing left to write
+            std::swap(snapshot, pending_);
+            has_pending_ = false;
+        }
+        // The write runs without the lock: request() never waits for it
+        snapshot.save(path_.c_str());
+    }
+}
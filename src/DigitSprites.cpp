@@ -0,0 +1,87 @@
+#include "DigitSprites.h"
+#include <cstring>
+
+DigitSprites::DigitSprites() : count_(0), font_(nullptr), top_(0), height_(0) {
+    memset(slots_, -1, sizeof(slots_));
+}
+
+bool DigitSprites::build(const BitmapFont& font, const RGBColor& color) {
+    if (font_ == &font && color.r == color_.r && color.g == color_.g && color.b == color_.b) return false;
+
+    // Glyphs whose ink stays inside their cell, and the rows where any has ink
+    const char* glyphs = DIGIT_SPRITE_GLYPHS;
+    const Glyph* cached[DIGIT_SPRITE_COUNT];
+    int top = 0, bottom = 0;
+    bool any = false;
+    count_ = 0;
+    memset(slots_, -1, sizeof(slots_));
+    for (const char* c = glyphs; *c; c++) {
+        if (font.characterWidth(*c) < 0) continue;
+        const Glyph* g = font.glyph(*c);
+        const GlyphSpan* span = font.spans() + g->first_span;
+        bool inside = true;
+        for (uint32_t i = 0; i < g->span_count; i++) {
+            if (span[i].x < 0 || span[i].x + span[i].length > g->advance) inside = false;
+        }
+        if (!inside) continue;
+
+        for (uint32_t i = 0; i < g->span_count; i++) {
+            if (!any || span[i].y < top) top = span[i].y;
+            if (!any || span[i].y + 1 > bottom) bottom = span[i].y + 1;
+            any = true;
+        }
+        cached[count_] = g;
+        slots_[static_cast<int>(*c)] = static_cast<int8_t>(count_);
+        sprites_[count_].advance = g->advance;
+        count_++;
+    }
+    top_ = top;
+    height_ = bottom - top;
+
+    // One image per glyph, back to back
+    size_t size = 0;
+    for (int s = 0; s < count_; s++) {
+        sprites_[s].offset = size;
+        size += sprites_[s].advance * height_ * 3;
+    }
+    pixels_.assign(size, 0);
+    for (int s = 0; s < count_; s++) {
+        const Glyph* g = cached[s];
+        const GlyphSpan* span = font.spans() + g->first_span;
+        for (uint32_t i = 0; i < g->span_count; i++, span++) {
+            uint8_t* p = &pixels_[sprites_[s].offset + ((span->y - top_) * g->advance + span->x) * 3];
+            for (int k = 0; k < span->length; k++, p += 3) {
+                p[0] = color.r;
+                p[1] = color.g;
+                p[2] = color.b;
+            }
+        }
+    }
+    font_ = &font;
+    color_ = color;
+    return true;
+}
+
+const uint8_t* DigitSprites::image(uint32_t codepoint) const {
+    // Sprites without rows (no ink at all) are drawn as text
+    const Sprite* s = find(codepoint);
+    return s && !pixels_.empty() ? &pixels_[0] + s->offset : nullptr;
+}
+
+int DigitSprites::advance(uint32_t codepoint) const {
+    const Sprite* s = find(codepoint);
+    return s ? s->advance : 0;
+}
+
+int DigitSprites::top() const {
+    return top_;
+}
+
+int DigitSprites::height() const {
+    return height_;
+}
+
+const DigitSprites::Sprite* DigitSprites::find(uint32_t codepoint) const {
+    if (codepoint >= DIGIT_SPRITE_SLOTS || slots_[codepoint] < 0) return nullptr;
+    return &sprites_[slots_[codepoint]];
+}
@@ -0,0 +1,14 @@
+#include "Display.h"
+#ifdef HEADLESS_DISPLAY
+#include "HeadlessDisplay.h"
+#else
+#include "MatrixDisplay.h"
+#endif
+
+Display* createDisplay(int width, int height, int brightness) {
+#ifdef HEADLESS_DISPLAY
+    return new HeadlessDisplay(width, height, brightness);
+#else
+    return new MatrixDisplay(width, height, brightness);
+#endif
+}
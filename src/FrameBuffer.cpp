@@ -0,0 +1,180 @@
+#include "FrameBuffer.h"
+#include "Utf8.h"
+#include <cstring>
+
+FrameBuffer::FrameBuffer(int width, int height)
+    : width_(width), height_(height), pixels_(width * height * 3, 0),
+      row_min_(height, width), row_max_(height, 0) {
+    dirty_.x0 = dirty_.y0 = dirty_.x1 = dirty_.y1 = 0;
+    resetClip();
+}
+
+void FrameBuffer::clear() {
+    for (int y = 0; y < height_; y++) {
+        if (row_min_[y] >= row_max_[y]) continue;
+
+        memset(&pixels_[(y * width_ + row_min_[y]) * 3], 0, (row_max_[y] - row_min_[y]) * 3);
+        Rect row = { row_min_[y], y, row_max_[y], y + 1 };
+        dirty_ = unite(dirty_, row);
+        row_min_[y] = width_;
+        row_max_[y] = 0;
+    }
+}
+
+void FrameBuffer::setClip(int x0, int y0, int x1, int y1) {
+    clip_.x0 = x0 > 0 ? x0 : 0;
+    clip_.y0 = y0 > 0 ? y0 : 0;
+    clip_.x1 = x1 < width_ ? x1 : width_;
+    clip_.y1 = y1 < height_ ? y1 : height_;
+}
+
+void FrameBuffer::resetClip() {
+    clip_.x0 = clip_.y0 = 0;
+    clip_.x1 = width_;
+    clip_.y1 = height_;
+}
+
+void FrameBuffer::setPixel(int x, int y, const RGBColor& color) {
+    fillSpan(x, y, 1, color);
+}
+
+void FrameBuffer::fillSpan(int x, int y, int length, const RGBColor& color) {
+    if (y < clip_.y0 || y >= clip_.y1) return;
+    if (x < clip_.x0) {
+        length -= clip_.x0 - x;
+        x = clip_.x0;
+    }
+    if (x + length > clip_.x1) length = clip_.x1 - x;
+    if (length <= 0) return;
+
+    uint8_t* p = &pixels_[(y * width_ + x) * 3];
+    for (int i = 0; i < length; i++) {
+        p[0] = color.r;
+        p[1] = color.g;
+        p[2] = color.b;
+        p += 3;
+    }
+    touch(x, y, x + length, y + 1);
+}
+
+void FrameBuffer::fillRect(int x, int y, int w, int h, const RGBColor& color) {
+    for (int row = 0; row < h; row++) {
+        fillSpan(x, y + row, w, color);
+    }
+}
+
+void FrameBuffer::blit(int x, int y, int w, int h, const uint8_t* rgb) {
+    // Clip once, then copy whole rows
+    int skip_x = x < clip_.x0 ? clip_.x0 - x : 0;
+    int skip_y = y < clip_.y0 ? clip_.y0 - y : 0;
+    int copy_w = (x + w > clip_.x1 ? clip_.x1 - x : w) - skip_x;
+    int copy_h = (y + h > clip_.y1 ? clip_.y1 - y : h) - skip_y;
+    if (copy_w <= 0 || copy_h <= 0) return;
+
+    for (int row = skip_y; row < skip_y + copy_h; row++) {
+        memcpy(&pixels_[((y + row) * width_ + x + skip_x) * 3], rgb + (row * w + skip_x) * 3, copy_w * 3);
+    }
+    touch(x + skip_x, y + skip_y, x + skip_x + copy_w, y + skip_y + copy_h);
+}
+
+void FrameBuffer::assign(const uint8_t* rgb) {
+    // Per row: copy and touch only the range between the first and last difference
+    int row_bytes = width_ * 3;
+    for (int y = 0; y < height_; y++) {
+        uint8_t* dst = &pixels_[y * row_bytes];
+        const uint8_t* src = rgb + y * row_bytes;
+        if (memcmp(dst, src, row_bytes) == 0) continue;
+
+        int x0 = 0, x1 = width_;
+        while (memcmp(dst + x0 * 3, src + x0 * 3, 3) == 0) x0++;
+        while (memcmp(dst + (x1 - 1) * 3, src + (x1 - 1) * 3, 3) == 0) x1--;
+        memcpy(dst + x0 * 3, src + x0 * 3, (x1 - x0) * 3);
+        touch(x0, y, x1, y + 1);
+    }
+}
+
+int FrameBuffer::drawText(const BitmapFont& font, int x, int y, const RGBColor& color, const char* utf8_text) {
+    const char* end = utf8_text + strlen(utf8_text);
+    int pen = x;
+    while (utf8_text < end) {
+        pen += drawGlyph(font, pen, y, color, utf8NextCodepoint(utf8_text, end));
+    }
+    return pen - x;
+}
+
+int FrameBuffer::drawGlyph(const BitmapFont& font, int x, int y, const RGBColor& color, uint32_t codepoint) {
+    const Glyph* g = font.glyph(codepoint);
+    if (!g) return 0;
+
+    const GlyphSpan* span = font.spans() + g->first_span;
+    for (uint32_t i = 0; i < g->span_count; i++, span++) {
+        fillSpan(x + span->x, y + span->y, span->length, color);
+    }
+    return g->advance;
+}
+
+void FrameBuffer::transfer(DisplayCanvas* canvas) {
+    // Area this canvas is missing: all of it the first time it is seen
+    Rect region = dirty_;
+    bool known = false;
+    for (size_t i = 0; i < canvases_.size(); i++) {
+        if (canvases_[i].canvas == canvas) {
+            region = unite(region, canvases_[i].stale);
+            canvases_[i].stale.x0 = canvases_[i].stale.x1 = 0;
+            known = true;
+        } else {
+            canvases_[i].stale = unite(canvases_[i].stale, dirty_);
+        }
+    }
+    if (!known) {
+        Rect all = { 0, 0, width_, height_ };
+        region = all;
+        CanvasState state = { canvas, { 0, 0, 0, 0 } };
+        canvases_.push_back(state);
+    }
+    dirty_.x0 = dirty_.x1 = 0;
+
+    for (int y = region.y0; y < region.y1; y++) {
+        const uint8_t* p = &pixels_[(y * width_ + region.x0) * 3];
+        for (int x = region.x0; x < region.x1; x++, p += 3) {
+            canvas->setPixel(x, y, p[0], p[1], p[2]);
+        }
+    }
+}
+
+void FrameBuffer::invalidate() {
+    canvases_.clear();
+}
+
+int FrameBuffer::width() const {
+    return width_;
+}
+
+int FrameBuffer::height() const {
+    return height_;
+}
+
+const uint8_t* FrameBuffer::pixels() const {
+    return pixels_.empty() ? nullptr : &pixels_[0];
+}
+
+void FrameBuffer::touch(int x0, int y0, int x1, int y1) {
+    Rect r = { x0, y0, x1, y1 };
+    dirty_ = unite(dirty_, r);
+    for (int y = y0; y < y1; y++) {
+        if (x0 < row_min_[y]) row_min_[y] = x0;
+        if (x1 > row_max_[y]) row_max_[y] = x1;
+    }
+}
+
+FrameBuffer::Rect FrameBuffer::unite(const Rect& a, const Rect& b) {
+    if (a.x0 >= a.x1 || a.y0 >= a.y1) return b;
+    if (b.x0 >= b.x1 || b.y0 >= b.y1) return a;
+
+    Rect r;
+    r.x0 = a.x0 < b.x0 ? a.x0 : b.x0;
+    r.y0 = a.y0 < b.y0 ? a.y0 : b.y0;
+    r.x1 = a.x1 > b.x1 ? a.x1 : b.x1;
+    r.y1 = a.y1 > b.y1 ? a.y1 : b.y1;
+    return r;
+}
@@ -0,0 +1,29 @@
+#include "FrameKey.h"
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+FrameKey::FrameKey() : hash_(FNV_OFFSET_BASIS) {}
+
+void FrameKey::reset() {
+    hash_ = FNV_OFFSET_BASIS;
+}
+
+FrameKey& FrameKey::add(const char* text) {
+    for (; *text; text++) mix(static_cast<uint8_t>(*text));
+    mix(0);
+    return *this;
+}
+
+FrameKey& FrameKey::add(int64_t value) {
+    for (int i = 0; i < 8; i++) mix(static_cast<uint8_t>(value >> (i * 8)));
+    return *this;
+}
+
+uint64_t FrameKey::value() const {
+    return hash_;
+}
+
+void FrameKey::mix(uint8_t byte) {
+    hash_ = (hash_ ^ byte) * FNV_PRIME;
+}
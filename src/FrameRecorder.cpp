@@ -0,0 +1,138 @@
+#include "FrameRecorder.h"
+#include "Config.h"
+#include "MonotonicClock.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// Clamp to a byte
+static inline uint8_t clampByte(int v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+FrameRecorder::FrameRecorder(int width, int height)
+    : width_(width), height_(height), y4m_(false), file_(nullptr), start_us_(0),
+      stopping_(false), wake_fd_(-1), written_(0), dropped_(0) {}
+
+FrameRecorder::~FrameRecorder() {
+    close();
+}
+
+bool FrameRecorder::open(const std::string& path) {
+    if (file_) return true;
+
+    y4m_ = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+    file_ = fopen(path.c_str(), "wb");
+    if (!file_) {
+        fprintf(stderr, "Failed to open %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+    wake_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        perror("eventfd");
+        fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+
+    // Nominal rate of the animation frames; each frame carries its own time
+    if (y4m_) {
+        fprintf(file_, "YUV4MPEG2 W%d H%d F1000:%d Ip A1:1 C444 XCOLORRANGE=FULL\n", width_, height_, FRAME_INTERVAL_MS);
+        planes_.assign(width_ * height_ * 3, 0);
+    }
+
+    // Every slot starts free
+    slots_.assign(RECORDER_SLOTS, std::vector<uint8_t>(width_ * height_ * 3));
+    for (int i = 0; i < RECORDER_SLOTS; i++) free_.push(i);
+
+    path_ = path;
+    start_us_ = monotonicUs();
+    written_ = 0;
+    dropped_ = 0;
+    stopping_ = false;
+    thread_ = std::thread(&FrameRecorder::threadLoop, this);
+    return true;
+}
+
+void FrameRecorder::close() {
+    if (!file_) return;
+
+    stopping_ = true;
+    uint64_t one = 1;
+    if (::write(wake_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+    thread_.join();
+    ::close(wake_fd_);
+    wake_fd_ = -1;
+    if (ferror(file_)) fprintf(stderr, "⚠ Write error while recording to %s\n", path_.c_str());
+    fclose(file_);
+    file_ = nullptr;
+
+    // Return the slots for a later open()
+    Entry entry;
+    while (queued_.pop(entry)) {}
+    int slot;
+    while (free_.pop(slot)) {}
+
+    printf("🎞  Recorded %lu frames to %s (%lu dropped)\n", written_, path_.c_str(), dropped_.load());
+}
+
+void FrameRecorder::record(const uint8_t* rgb, int64_t time_us) {
+    if (!file_) return;
+
+    int slot;
+    if (!free_.pop(slot)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    memcpy(&slots_[slot][0], rgb, slots_[slot].size());
+    Entry entry = { slot, time_us - start_us_ };
+    queued_.push(entry);
+
+    uint64_t one = 1;
+    if (::write(wake_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+}
+
+bool FrameRecorder::recording() const {
+    return file_ != nullptr;
+}
+
+void FrameRecorder::threadLoop() {
+    for (;;) {
+        uint64_t count;
+        if (read(wake_fd_, &count, sizeof(count)) < 0 && errno != EINTR) break;
+
+        // Drain everything queued, then exit if asked to
+        bool stop = stopping_;
+        Entry entry;
+        while (queued_.pop(entry)) {
+            write(&slots_[entry.slot][0], entry.time_us);
+            free_.push(entry.slot);
+        }
+        if (stop) break;
+    }
+    fflush(file_);
+}
+
+void FrameRecorder::write(const uint8_t* rgb, int64_t time_us) {
+    size_t size = width_ * height_ * 3;
+    if (y4m_) {
+        // Full-range BT.601, one plane per component
+        int count = width_ * height_;
+        uint8_t* y = &planes_[0];
+        uint8_t* u = y + count;
+        uint8_t* v = u + count;
+        for (int i = 0; i < count; i++, rgb += 3) {
+            int r = rgb[0], g = rgb[1], b = rgb[2];
+            y[i] = clampByte((77 * r + 150 * g + 29 * b + 128) >> 8);
+            u[i] = clampByte((-43 * r - 85 * g + 128 * b + 32896) >> 8);
+            v[i] = clampByte((128 * r - 107 * g - 21 * b + 32896) >> 8);
+        }
+        fprintf(file_, "FRAME Xt=%lld\n", static_cast<long long>(time_us));
+        fwrite(&planes_[0], 1, size, file_);
+    } else {
+        fprintf(file_, "P6\n# t=%lld\n%d %d\n255\n", static_cast<long long>(time_us), width_, height_);
+        fwrite(rgb, 1, size, file_);
+    }
+    written_++;
+}
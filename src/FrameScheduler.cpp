@@ -0,0 +1,165 @@
+#include "FrameScheduler.h"
+#include "Config.h"
+#include "MonotonicClock.h"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+
+FrameScheduler::FrameScheduler()
+    : epoll_fd_(-1), deadline_fd_(-1), wall_fd_(-1), notify_fd_(-1), signal_fd_(-1),
+      next_deadline_ms_(-1), wall_period_s_(0), lateness_us_(-1) {
+    sigemptyset(&signals_);
+    sigemptyset(&received_);
+}
+
+FrameScheduler::~FrameScheduler() {
+    int fds[] = { epoll_fd_, deadline_fd_, wall_fd_, notify_fd_, signal_fd_ };
+    for (size_t i = 0; i < sizeof(fds) / sizeof(fds[0]); i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+}
+
+bool FrameScheduler::setup(const sigset_t& signals) {
+    signals_ = signals;
+    if (pthread_sigmask(SIG_BLOCK, &signals_, NULL) != 0) return false;
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    deadline_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    wall_fd_ = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+    notify_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    signal_fd_ = signalfd(-1, &signals_, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    bool ok = epoll_fd_ >= 0 && deadline_fd_ >= 0 && wall_fd_ >= 0 && notify_fd_ >= 0 && signal_fd_ >= 0;
+    int fds[] = { deadline_fd_, wall_fd_, notify_fd_, signal_fd_ };
+    for (size_t i = 0; ok && i < sizeof(fds) / sizeof(fds[0]); i++) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fds[i];
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fds[i], &ev) < 0) ok = false;
+    }
+
+    if (!ok) {
+        perror("FrameScheduler setup");
+        int all[] = { epoll_fd_, deadline_fd_, wall_fd_, notify_fd_, signal_fd_ };
+        for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); i++) {
+            if (all[i] >= 0) close(all[i]);
+        }
+        epoll_fd_ = deadline_fd_ = wall_fd_ = notify_fd_ = signal_fd_ = -1;
+        pthread_sigmask(SIG_UNBLOCK, &signals_, NULL);
+        return false;
+    }
+    return true;
+}
+
+int FrameScheduler::notifyFd() const {
+    return notify_fd_;
+}
+
+void FrameScheduler::wakeAt(long time_ms) {
+    if (next_deadline_ms_ < 0 || time_ms < next_deadline_ms_) next_deadline_ms_ = time_ms;
+}
+
+void FrameScheduler::wakeOnWallBoundary(int period_s) {
+    if (period_s <= 0) return;
+    if (wall_period_s_ == 0 || period_s < wall_period_s_) wall_period_s_ = period_s;
+}
+
+int FrameScheduler::wait() {
+    if (epoll_fd_ < 0) return sleepFallback();
+
+    // Arm (or disarm) both timers for this wait
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    long deadline_ms = -1;
+    if (next_deadline_ms_ >= 0) {
+        // An absolute time of zero would disarm the timer
+        long at = next_deadline_ms_ > 0 ? next_deadline_ms_ : 1;
+        deadline_ms = at;
+        spec.it_value.tv_sec = at / 1000;
+        spec.it_value.tv_nsec = (at % 1000) * 1000000;
+    }
+    timerfd_settime(deadline_fd_, TFD_TIMER_ABSTIME, &spec, NULL);
+
+    memset(&spec, 0, sizeof(spec));
+    if (wall_period_s_ > 0) {
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        spec.it_value.tv_sec = (now.tv_sec / wall_period_s_ + 1) * wall_period_s_;
+    }
+    time_t wall_s = spec.it_value.tv_sec;
+    timerfd_settime(wall_fd_, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, NULL);
+
+    next_deadline_ms_ = -1;
+    wall_period_s_ = 0;
+
+    struct epoll_event ready[4];
+    int n = epoll_wait(epoll_fd_, ready, 4, -1);
+    lateness_us_ = -1;
+    if (n < 0) return errno == EINTR ? WAKE_SIGNAL : 0;
+
+    int wake = 0;
+    for (int i = 0; i < n; i++) {
+        int fd = ready[i].data.fd;
+        uint64_t count;
+        if (fd == deadline_fd_) {
+            if (read(fd, &count, sizeof(count)) > 0) {
+                wake |= WAKE_DEADLINE;
+                updateLateness(clockUs(CLOCK_MONOTONIC) - static_cast<int64_t>(deadline_ms) * 1000);
+            }
+        } else if (fd == wall_fd_) {
+            // ECANCELED: the clock was set, redraw right away
+            if (read(fd, &count, sizeof(count)) > 0) {
+                wake |= WAKE_WALL;
+                updateLateness(clockUs(CLOCK_REALTIME) - static_cast<int64_t>(wall_s) * 1000000);
+            } else if (errno == ECANCELED) {
+                wake |= WAKE_WALL;
+            }
+        } else if (fd == notify_fd_) {
+            if (read(fd, &count, sizeof(count)) > 0) wake |= WAKE_INPUT;
+        } else if (fd == signal_fd_) {
+            struct signalfd_siginfo info;
+            while (read(fd, &info, sizeof(info)) == sizeof(info)) {
+                sigaddset(&received_, info.ssi_signo);
+                wake |= WAKE_SIGNAL;
+            }
+        }
+    }
+    return wake;
+}
+
+bool FrameScheduler::takeSignal(int signo) {
+    if (!sigismember(&received_, signo)) return false;
+    sigdelset(&received_, signo);
+    return true;
+}
+
+int64_t FrameScheduler::lateness() const {
+    return lateness_us_;
+}
+
+void FrameScheduler::updateLateness(int64_t late_us) {
+    // Both timers expired: the wait should have ended at the earlier one
+    if (late_us < 0) late_us = 0;
+    if (late_us > lateness_us_) lateness_us_ = late_us;
+}
+
+int FrameScheduler::sleepFallback() {
+    long sleep_ms = FRAME_INTERVAL_MS;
+    if (next_deadline_ms_ >= 0) {
+        long remaining = next_deadline_ms_ - monotonicMs();
+        if (remaining < sleep_ms) sleep_ms = remaining > 0 ? remaining : 0;
+    }
+    next_deadline_ms_ = -1;
+    wall_period_s_ = 0;
+    lateness_us_ = -1;
+
+    usleep(sleep_ms * 1000);
+    return WAKE_DEADLINE;
+}
@@ -0,0 +1,33 @@
+#include "FrameStats.h"
+
+static const char* const STAGE_NAMES[FrameStats::STAGE_COUNT] = {
+    "input", "update", "jitter", "layout", "draw", "overlay", "transfer", "swap", "frame"
+};
+
+FrameStats::FrameStats() {}
+
+void FrameStats::record(Stage stage, int64_t us) {
+    std::lock_guard<std::mutex> lock(locks_[stage]);
+    histograms_[stage].record(us);
+}
+
+void FrameStats::report(FILE* out) const {
+    fprintf(out, "⏱  Frame stages (µs):\n");
+    fprintf(out, "    %-20s %8s %8s %8s %8s\n", "stage", "count", "p50", "p99", "max");
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        // Copy under the lock, format without it
+        uint64_t count;
+        int64_t p50, p99, max;
+        {
+            std::lock_guard<std::mutex> lock(locks_[i]);
+            const Histogram& h = histograms_[i];
+            count = h.count();
+            p50 = h.percentile(50);
+            p99 = h.percentile(99);
+            max = h.max();
+        }
+        fprintf(out, "    %-20s %8llu %8lld %8lld %8lld\n", STAGE_NAMES[i], static_cast<unsigned long long>(count),
+                static_cast<long long>(p50), static_cast<long long>(p99), static_cast<long long>(max));
+    }
+    fflush(out);
+}
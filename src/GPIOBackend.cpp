@@ -0,0 +1,36 @@
+#include "GPIOBackend.h"
+#include "GPIOChipBackend.h"
+#include "GPIOMemBackend.h"
+#include "PinctrlBackend.h"
+#include "SimulatedBackend.h"
+#include "Config.h"
+#include <cstdio>
+
+GPIOBackend* createGPIOBackend(const std::string& spec, int pin) {
+    std::string chip_path;
+    if (isGPIOChipSpec(spec, chip_path)) {
+        if (spec != "gpiochip" && spec.compare(0, 9, "gpiochip:") != 0) {
+            fprintf(stderr, "⚠ Unknown button backend \"%s\", using gpiochip\n", spec.c_str());
+        }
+        return new GPIOChipBackend(pin, chip_path);
+    }
+    if (spec == "pinctrl") {
+        return new PinctrlBackend(pin);
+    }
+    if (spec == "gpiomem") {
+        return new GPIOMemBackend(pin);
+    }
+    if (spec.compare(0, 8, "gpiomem:") == 0) {
+        return new GPIOMemBackend(pin, spec.substr(8));
+    }
+    return new SimulatedBackend(spec.substr(4), true, pin);
+}
+
+bool isGPIOChipSpec(const std::string& spec, std::string& chip_path) {
+    if (spec == "pinctrl" || spec == "gpiomem" || spec.compare(0, 8, "gpiomem:") == 0 ||
+        spec.compare(0, 4, "sim:") == 0) {
+        return false;
+    }
+    chip_path = spec.compare(0, 9, "gpiochip:") == 0 ? spec.substr(9) : std::string(GPIO_CHIP);
+    return true;
+}
@@ -1,97 +1,115 @@
 #include "GPIOButton.h"
 #include <cstdio>
-#include <cstring>
-#include <cstdlib>
 
-GPIOButton::GPIOButton(int pin, int debounce_ms, int long_press_ms)
-    : pin_(pin), debounce_ms_(debounce_ms), long_press_ms_(long_press_ms),
-      last_value_(1), button_press_start_(0), button_was_pressed_(false),
-      long_press_triggered_(false) {}
+GPIOButton::GPIOButton(GPIOBackend* backend, const GestureTiming& timing)
+    : backend_(backend), recognizer_(timing), queued_(false) {
+    recognizer_.setSink([this](const ButtonEvent& event) { emit(event); });
+}
 
 GPIOButton::~GPIOButton() {}
 
 bool GPIOButton::setup() {
-    char cmd[64];
-    snprintf(cmd, sizeof(cmd), "pinctrl set %d ip pu", pin_);
-    return system(cmd) == 0;
+    if (!backend_->setup()) {
+        GPIOBackend* fallback = backend_->fallback();
+        if (!fallback) return false;
+
+        fprintf(stderr, "⚠ GPIO backend %s unavailable, falling back to %s\n", backend_->name(), fallback->name());
+        backend_.reset(fallback);
+        if (!backend_->setup()) return false;
+    }
+    return true;
 }
 
-int GPIOButton::read() {
-    char cmd[64];
-    snprintf(cmd, sizeof(cmd), "pinctrl lev %d 2>/dev/null", pin_);
+void GPIOButton::poll(long current_time_ms) {
+    if (queued_) {
+        // Queued mode: the input thread already classified the gestures
+        ButtonEvent event;
+        while (events_.pop(event)) invoke(event);
+        return;
+    }
 
-    FILE* pipe = popen(cmd, "r");
-    if (!pipe) return -1;
+    process(current_time_ms);
+}
 
-    char buffer[128];
-    if (fgets(buffer, sizeof(buffer), pipe)) {
-        pclose(pipe);
-        return (strchr(buffer, '1') != NULL) ? 1 : 0;
+void GPIOButton::process(long current_time_ms) {
+    // Replay queued edges with their own timestamps
+    GPIOEdge edge;
+    while (backend_->readEdge(edge)) {
+        recognizer_.edge(edge.value, edge.time_ms);
     }
 
-    pclose(pipe);
-    return -1;
+    // Level-only backends report changes through the sampled value
+    int gpio_value = backend_->read();
+    if (gpio_value >= 0) recognizer_.edge(gpio_value, current_time_ms);
+    recognizer_.tick(current_time_ms);
 }
 
-void GPIOButton::poll(long current_time_ms) {
-    int gpio_value = read();
-    if (gpio_value < 0) return;
+void GPIOButton::setQueued(bool queued) {
+    queued_ = queued;
+}
 
-    // Detect falling edge (button pressed)
-    if (last_value_ == 1 && gpio_value == 0) {
-        button_press_start_ = current_time_ms;
-        button_was_pressed_ = true;
-        long_press_triggered_ = false;
+long GPIOButton::nextDeadline() const {
+    return recognizer_.nextDeadline();
+}
 
-        // Call onPress callback
-        if (press_callback_) press_callback_();
-    }
-    // Check for long press while button is held
-    else if (gpio_value == 0 && button_was_pressed_ && !long_press_triggered_) {
-        long press_duration = current_time_ms - button_press_start_;
-
-        if (press_duration >= long_press_ms_) {
-            long_press_triggered_ = true;
-            // Call onLongPress callback
-            if (long_press_callback_) long_press_callback_();
-        }
-    }
-    // Detect rising edge (button released)
-    else if (last_value_ == 0 && gpio_value == 1 && button_was_pressed_) {
-        long press_duration = current_time_ms - button_press_start_;
+bool GPIOButton::hasQueuedEvents() const {
+    return !events_.empty();
+}
 
-        // Call onRelease callback
-        if (release_callback_) release_callback_();
+void GPIOButton::emit(const ButtonEvent& event) {
+    if (queued_) {
+        if (!events_.push(event)) fprintf(stderr, "⚠ Button event queue full, event dropped\n");
+    } else {
+        invoke(event);
+    }
+}
 
-        // Call onTap callback only if long press was not triggered
-        if (!long_press_triggered_ && press_duration >= debounce_ms_) {
-            if (tap_callback_) tap_callback_();
-        }
+void GPIOButton::invoke(const ButtonEvent& event) {
+    if (!callbacks_[event.type]) return;
 
-        button_was_pressed_ = false;
-        long_press_triggered_ = false;
-    }
+    if (dispatch_observer_) dispatch_observer_(event);
+    callbacks_[event.type]();
+}
 
-    last_value_ = gpio_value;
+void GPIOButton::onDispatch(std::function<void(const ButtonEvent&)> observer) {
+    dispatch_observer_ = observer;
 }
 
 void GPIOButton::onPress(std::function<void()> callback) {
-    press_callback_ = callback;
+    callbacks_[ButtonEvent::PRESS] = callback;
 }
 
 void GPIOButton::onRelease(std::function<void()> callback) {
-    release_callback_ = callback;
+    callbacks_[ButtonEvent::RELEASE] = callback;
 }
 
 void GPIOButton::onTap(std::function<void()> callback) {
-    tap_callback_ = callback;
+    callbacks_[ButtonEvent::TAP] = callback;
+}
+
+void GPIOButton::onDoubleTap(std::function<void()> callback) {
+    callbacks_[ButtonEvent::DOUBLE_TAP] = callback;
+    recognizer_.setMultiTapEnabled(true);
+}
+
+void GPIOButton::onTripleTap(std::function<void()> callback) {
+    callbacks_[ButtonEvent::TRIPLE_TAP] = callback;
+    recognizer_.setMultiTapEnabled(true);
 }
 
 void GPIOButton::onLongPress(std::function<void()> callback) {
-    long_press_callback_ = callback;
+    callbacks_[ButtonEvent::LONG_PRESS] = callback;
+}
+
+void GPIOButton::onHoldRepeat(std::function<void()> callback) {
+    callbacks_[ButtonEvent::HOLD_REPEAT] = callback;
+}
+
+void GPIOButton::onHoldRelease(std::function<void()> callback) {
+    callbacks_[ButtonEvent::HOLD_RELEASE] = callback;
 }
 
 void GPIOButton::onShortPress(std::function<void()> callback) {
     // Alias for onTap for legacy compatibility
-    tap_callback_ = callback;
+    callbacks_[ButtonEvent::TAP] = callback;
 }
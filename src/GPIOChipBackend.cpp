@@ -0,0 +1,69 @@
+#include "GPIOChipBackend.h"
+#include "PinctrlBackend.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+GPIOChipBackend::GPIOChipBackend(int pin, const std::string& chip_path)
+    : pin_(pin), chip_path_(chip_path), line_fd_(-1), event_count_(0), event_next_(0) {}
+
+GPIOChipBackend::~GPIOChipBackend() {
+    if (line_fd_ >= 0) close(line_fd_);
+}
+
+bool GPIOChipBackend::setup() {
+    int chip_fd = open(chip_path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (chip_fd < 0) return false;
+
+    struct gpio_v2_line_request req;
+    memset(&req, 0, sizeof(req));
+    req.offsets[0] = pin_;
+    req.num_lines = 1;
+    strncpy(req.consumer, "led-clock", sizeof(req.consumer) - 1);
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP |
+                       GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+
+    int ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+    close(chip_fd); // The line request fd stays valid without the chip fd
+    if (ret < 0) return false;
+
+    // Edges are drained until EAGAIN, which must never block the caller
+    fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
+    line_fd_ = req.fd;
+    return true;
+}
+
+int GPIOChipBackend::read() {
+    if (line_fd_ < 0) return -1;
+
+    struct gpio_v2_line_values values;
+    values.bits = 0;
+    values.mask = 1;
+    if (ioctl(line_fd_, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) return -1;
+    return (values.bits & 1) ? 1 : 0;
+}
+
+bool GPIOChipBackend::readEdge(GPIOEdge& edge) {
+    if (line_fd_ < 0) return false;
+
+    if (event_next_ >= event_count_) {
+        ssize_t n = ::read(line_fd_, events_, sizeof(events_));
+        if (n <= 0) return false;
+        event_count_ = n / sizeof(events_[0]);
+        event_next_ = 0;
+    }
+
+    const struct gpio_v2_line_event& event = events_[event_next_++];
+    edge.value = event.id == GPIO_V2_LINE_EVENT_RISING_EDGE ? 1 : 0;
+    edge.time_ms = static_cast<long>(event.timestamp_ns / 1000000);
+    return true;
+}
+
+int GPIOChipBackend::eventFd() const {
+    return line_fd_;
+}
+
+GPIOBackend* GPIOChipBackend::fallback() const {
+    return new PinctrlBackend(pin_);
+}
@@ -0,0 +1,88 @@
+#include "GPIOChipGroup.h"
+#include "PinctrlBackend.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+GPIOChipGroup::GPIOChipGroup(const std::string& chip_path, const std::vector<int>& pins)
+    : chip_path_(chip_path), pins_(pins), line_fd_(-1), values_(~0ULL), values_valid_(false),
+      edges_(pins.size()) {}
+
+GPIOChipGroup::~GPIOChipGroup() {
+    if (line_fd_ >= 0) close(line_fd_);
+}
+
+bool GPIOChipGroup::setup() {
+    if (pins_.empty() || pins_.size() > GPIO_V2_LINES_MAX) return false;
+
+    int chip_fd = open(chip_path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (chip_fd < 0) return false;
+
+    struct gpio_v2_line_request req;
+    memset(&req, 0, sizeof(req));
+    for (size_t i = 0; i < pins_.size(); i++) {
+        req.offsets[i] = pins_[i];
+    }
+    req.num_lines = pins_.size();
+    strncpy(req.consumer, "led-clock", sizeof(req.consumer) - 1);
+    req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP |
+                       GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    req.event_buffer_size = 16 * pins_.size();
+
+    int ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+    close(chip_fd); // The line request fd stays valid without the chip fd
+    if (ret < 0) return false;
+
+    // Edges are drained until EAGAIN, which must never block the caller
+    fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
+    line_fd_ = req.fd;
+    return refresh();
+}
+
+bool GPIOChipGroup::refresh() {
+    if (line_fd_ < 0) return false;
+
+    // Demultiplex edge events by line offset
+    struct gpio_v2_line_event events[16];
+    ssize_t n;
+    while ((n = ::read(line_fd_, events, sizeof(events))) > 0) {
+        for (size_t i = 0; i < n / sizeof(events[0]); i++) {
+            for (size_t line = 0; line < pins_.size(); line++) {
+                if (static_cast<int>(events[i].offset) != pins_[line]) continue;
+
+                GPIOEdge edge;
+                edge.value = events[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE ? 1 : 0;
+                edge.time_ms = static_cast<long>(events[i].timestamp_ns / 1000000);
+                if (!edges_[line].push(edge)) fprintf(stderr, "⚠ GPIO %d edge queue full, edge dropped\n", pins_[line]);
+                break;
+            }
+        }
+    }
+
+    // One ioctl samples every requested line
+    struct gpio_v2_line_values values;
+    values.bits = 0;
+    values.mask = pins_.size() == 64 ? ~0ULL : (1ULL << pins_.size()) - 1;
+    values_valid_ = ioctl(line_fd_, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) >= 0;
+    if (values_valid_) values_ = values.bits;
+    return values_valid_;
+}
+
+GPIOBackend* GPIOChipGroup::line(size_t index) {
+    return new Line(this, index);
+}
+
+int GPIOChipGroup::Line::read() {
+    if (!group_->values_valid_) return -1;
+    return (group_->values_ >> index_) & 1 ? 1 : 0;
+}
+
+bool GPIOChipGroup::Line::readEdge(GPIOEdge& edge) {
+    return group_->edges_[index_].pop(edge);
+}
+
+GPIOBackend* GPIOChipGroup::Line::fallback() const {
+    return new PinctrlBackend(group_->pins_[index_]);
+}
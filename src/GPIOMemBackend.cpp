@@ -0,0 +1,90 @@
+#include "GPIOMemBackend.h"
+#include "PinctrlBackend.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// BCM283x/BCM2711 GPIO register word offsets
+static const int GPFSEL0 = 0x00 / 4;            // Function select, 3 bits per pin
+static const int GPLEV0 = 0x34 / 4;             // Pin levels, 1 bit per pin
+static const int GPPUD = 0x94 / 4;              // Pull-up/down control (BCM283x)
+static const int GPPUDCLK0 = 0x98 / 4;          // Pull-up/down clock (BCM283x)
+static const int GPIO_PUP_PDN_CNTRL0 = 0xe4 / 4; // Pull-up/down, 2 bits per pin (BCM2711)
+static const size_t GPIO_PAGE_SIZE = 4096;
+
+GPIOMemBackend::GPIOMemBackend(int pin, const std::string& path)
+    : pin_(pin), path_(path), regs_(nullptr), level_(nullptr), mask_(1u << (pin % 32)) {}
+
+GPIOMemBackend::~GPIOMemBackend() {
+    if (regs_) munmap(const_cast<uint32_t*>(regs_), GPIO_PAGE_SIZE);
+}
+
+bool GPIOMemBackend::setup() {
+    if (pin_ < 0 || pin_ > 53) return false;
+
+    int fd = open(path_.c_str(), O_RDWR | O_SYNC | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // A regular file standing in for the device must cover the whole page
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size < static_cast<off_t>(GPIO_PAGE_SIZE)) {
+        fprintf(stderr, "Fake GPIO register file %s is smaller than %zu bytes\n", path_.c_str(), GPIO_PAGE_SIZE);
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(nullptr, GPIO_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid without the fd
+    if (map == MAP_FAILED) return false;
+
+    regs_ = static_cast<volatile uint32_t*>(map);
+    level_ = regs_ + GPLEV0 + pin_ / 32;
+
+    // Function select: input (000). Not atomic: the word holds nine other
+    // pins, hence setup() before the matrix configures its own
+    volatile uint32_t* fsel = regs_ + GPFSEL0 + pin_ / 10;
+    *fsel = *fsel & ~(7u << ((pin_ % 10) * 3));
+
+    // The BCM2711 (Pi 4) moved the pull control to a per-pin register
+    bool bcm2711 = false;
+    FILE* compatible = fopen("/proc/device-tree/compatible", "r");
+    if (compatible) {
+        char buffer[256];
+        size_t n = fread(buffer, 1, sizeof(buffer) - 1, compatible);
+        fclose(compatible);
+        bcm2711 = memmem(buffer, n, "bcm2711", 7) != nullptr;
+    }
+    enablePullUp(bcm2711);
+    return true;
+}
+
+void GPIOMemBackend::enablePullUp(bool bcm2711) {
+    if (bcm2711) {
+        volatile uint32_t* reg = regs_ + GPIO_PUP_PDN_CNTRL0 + pin_ / 16;
+        int shift = (pin_ % 16) * 2;
+        *reg = (*reg & ~(3u << shift)) | (1u << shift); // 01 = pull-up
+        return;
+    }
+
+    // Legacy sequence: set control, clock it into the pin, then release both
+    // (the datasheet asks for 150 cycles between steps; 1us is plenty)
+    volatile uint32_t* clock = regs_ + GPPUDCLK0 + pin_ / 32;
+    *(regs_ + GPPUD) = 2; // 10 = pull-up
+    usleep(1);
+    *clock = mask_;
+    usleep(1);
+    *(regs_ + GPPUD) = 0;
+    *clock = 0;
+}
+
+int GPIOMemBackend::read() {
+    if (!level_) return -1;
+    return (*level_ & mask_) ? 1 : 0;
+}
+
+GPIOBackend* GPIOMemBackend::fallback() const {
+    return new PinctrlBackend(pin_);
+}
@@ -0,0 +1,112 @@
+#include "GestureRecognizer.h"
+
+GestureRecognizer::GestureRecognizer(const GestureTiming& timing)
+    : timing_(timing), multi_tap_enabled_(false), level_(1), pressed_(false), press_reported_(false), press_start_(0),
+      long_fired_(false), next_repeat_(0), tap_count_(0), tap_deadline_(-1) {}
+
+void GestureRecognizer::setSink(std::function<void(const ButtonEvent&)> sink) {
+    sink_ = sink;
+}
+
+void GestureRecognizer::setMultiTapEnabled(bool enabled) {
+    multi_tap_enabled_ = enabled;
+}
+
+void GestureRecognizer::edge(int value, long time_ms) {
+    // Anything due before this edge happened before it
+    fireDeadlines(time_ms);
+    if (value == level_) return;
+    level_ = value;
+
+    if (value == 0) {
+        // Press: a multi-tap in progress waits for this press to end.
+        // PRESS is reported once the press outlasts the debounce time.
+        pressed_ = true;
+        press_reported_ = false;
+        press_start_ = time_ms;
+        long_fired_ = false;
+        tap_deadline_ = -1;
+        fireDeadlines(time_ms);
+        return;
+    }
+
+    if (!pressed_) return;
+    pressed_ = false;
+
+    // Bounce: released before the debounce deadline fired, nothing to report
+    if (!press_reported_) {
+        if (tap_count_ > 0) tap_deadline_ = time_ms + timing_.multi_tap_ms;
+        return;
+    }
+    emit(ButtonEvent::RELEASE, time_ms);
+
+    if (long_fired_) {
+        emit(ButtonEvent::HOLD_RELEASE, time_ms);
+        return;
+    }
+
+    tap_count_++;
+
+    if (!multi_tap_enabled_ || timing_.multi_tap_ms <= 0 || tap_count_ >= 3) {
+        flushTaps(time_ms);
+    } else {
+        tap_deadline_ = time_ms + timing_.multi_tap_ms;
+    }
+}
+
+void GestureRecognizer::tick(long now_ms) {
+    fireDeadlines(now_ms);
+}
+
+long GestureRecognizer::nextDeadline() const {
+    if (pressed_ && !press_reported_) return press_start_ + timing_.debounce_ms;
+    if (pressed_ && !long_fired_) return press_start_ + timing_.long_press_ms;
+    if (pressed_ && timing_.repeat_interval_ms > 0) return next_repeat_;
+    if (!pressed_ && tap_deadline_ >= 0) return tap_deadline_;
+    return -1;
+}
+
+void GestureRecognizer::fireDeadlines(long until_ms) {
+    if (pressed_) {
+        long press_at = press_start_ + timing_.debounce_ms;
+        if (!press_reported_ && press_at <= until_ms) {
+            press_reported_ = true;
+            emit(ButtonEvent::PRESS, press_start_);
+        }
+        long long_press_at = press_start_ + timing_.long_press_ms;
+        if (press_reported_ && !long_fired_ && long_press_at <= until_ms) {
+            // Taps before this hold are complete gestures of their own
+            if (tap_count_ > 0) flushTaps(press_start_);
+            long_fired_ = true;
+            next_repeat_ = long_press_at + timing_.repeat_interval_ms;
+            emit(ButtonEvent::LONG_PRESS, long_press_at);
+        }
+        while (long_fired_ && timing_.repeat_interval_ms > 0 && next_repeat_ <= until_ms) {
+            emit(ButtonEvent::HOLD_REPEAT, next_repeat_);
+            next_repeat_ += timing_.repeat_interval_ms;
+        }
+    } else if (tap_deadline_ >= 0 && tap_deadline_ <= until_ms) {
+        flushTaps(tap_deadline_);
+    }
+}
+
+void GestureRecognizer::flushTaps(long time_ms) {
+    if (tap_count_ >= 3) {
+        emit(ButtonEvent::TRIPLE_TAP, time_ms);
+    } else if (tap_count_ == 2) {
+        emit(ButtonEvent::DOUBLE_TAP, time_ms);
+    } else if (tap_count_ == 1) {
+        emit(ButtonEvent::TAP, time_ms);
+    }
+    tap_count_ = 0;
+    tap_deadline_ = -1;
+}
+
+void GestureRecognizer::emit(ButtonEvent::Type type, long time_ms) {
+    if (!sink_) return;
+
+    ButtonEvent event;
+    event.type = type;
+    event.time_ms = time_ms;
+    sink_(event);
+}
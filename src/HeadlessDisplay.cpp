@@ -0,0 +1,68 @@
+#include "HeadlessDisplay.h"
+#include <algorithm>
+
+HeadlessDisplay::Canvas::Canvas(int width, int height, uint8_t brightness)
+    : rgb(width * height * 3, 0), width_(width), height_(height), brightness_(brightness) {}
+
+void HeadlessDisplay::Canvas::setPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) return;
+
+    uint8_t* p = &rgb[(y * width_ + x) * 3];
+    p[0] = r;
+    p[1] = g;
+    p[2] = b;
+}
+
+void HeadlessDisplay::Canvas::setBrightness(uint8_t percent) {
+    brightness_ = percent;
+}
+
+uint8_t HeadlessDisplay::Canvas::brightness() const {
+    return brightness_;
+}
+
+HeadlessDisplay::HeadlessDisplay(int width, int height, int brightness)
+    : width_(width), height_(height),
+      canvases_{ Canvas(width, height, brightness), Canvas(width, height, brightness) },
+      front_(0), brightness_(brightness), frames_(0) {}
+
+bool HeadlessDisplay::setup() {
+    return true;
+}
+
+int HeadlessDisplay::width() const {
+    return width_;
+}
+
+int HeadlessDisplay::height() const {
+    return height_;
+}
+
+DisplayCanvas* HeadlessDisplay::offscreen() {
+    return &canvases_[1 - front_];
+}
+
+void HeadlessDisplay::swap() {
+    front_ = 1 - front_;
+    frames_++;
+}
+
+void HeadlessDisplay::setBrightness(uint8_t percent) {
+    brightness_ = percent;
+}
+
+void HeadlessDisplay::clear() {
+    std::fill(canvases_[front_].rgb.begin(), canvases_[front_].rgb.end(), 0);
+}
+
+const uint8_t* HeadlessDisplay::pixels() const {
+    return &canvases_[front_].rgb[0];
+}
+
+uint8_t HeadlessDisplay::brightness() const {
+    return brightness_;
+}
+
+unsigned long HeadlessDisplay::frames() const {
+    return frames_;
+}
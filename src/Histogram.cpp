@@ -0,0 +1,56 @@
+#include "Histogram.h"
+#include <cstring>
+
+Histogram::Histogram() {
+    reset();
+}
+
+void Histogram::reset() {
+    memset(buckets_, 0, sizeof(buckets_));
+    count_ = 0;
+    max_ = 0;
+}
+
+int Histogram::bucketOf(uint64_t value) {
+    if (value < SUB_BUCKETS) return static_cast<int>(value);
+
+    // Power of two selects the bucket group, the next SUB_BITS bits the sub-bucket
+    int exponent = 63 - __builtin_clzll(value);
+    int bucket = (exponent - SUB_BITS + 1) * SUB_BUCKETS +
+                 static_cast<int>((value >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+    return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+int64_t Histogram::bucketValue(int bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+
+    int exponent = bucket / SUB_BUCKETS + SUB_BITS - 1;
+    int sub = bucket % SUB_BUCKETS;
+    int64_t width = 1LL << (exponent - SUB_BITS);
+    return (static_cast<int64_t>(SUB_BUCKETS + sub) << (exponent - SUB_BITS)) + width / 2;
+}
+
+void Histogram::record(int64_t value) {
+    if (value < 0) value = 0;
+    buckets_[bucketOf(static_cast<uint64_t>(value))]++;
+    count_++;
+    if (value > max_) max_ = value;
+}
+
+int64_t Histogram::percentile(double percentile) const {
+    if (count_ == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * count_ + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > count_) rank = count_;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            int64_t value = bucketValue(i);
+            return value < max_ ? value : max_;
+        }
+    }
+    return max_;
+}
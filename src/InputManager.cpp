@@ -0,0 +1,189 @@
+#include "InputManager.h"
+#include "MonotonicClock.h"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+InputManager::InputManager(const std::string& backend_spec, const std::vector<ButtonConfig>& buttons,
+                           const GestureTiming& timing)
+    : backend_spec_(backend_spec), configs_(buttons), timing_(timing), running_(false), stop_fd_(-1), epoll_fd_(-1), notify_fd_(-1) {}
+
+InputManager::~InputManager() {
+    stop();
+}
+
+bool InputManager::setup() {
+    std::string chip_path;
+    bool use_chip = isGPIOChipSpec(backend_spec_, chip_path);
+    if (use_chip) {
+        if (backend_spec_ != "gpiochip" && backend_spec_.compare(0, 9, "gpiochip:") != 0) {
+            fprintf(stderr, "⚠ Unknown button backend \"%s\", using gpiochip\n", backend_spec_.c_str());
+        }
+
+        std::vector<int> pins;
+        for (size_t i = 0; i < configs_.size(); i++) {
+            pins.push_back(configs_[i].pin);
+        }
+        group_.reset(new GPIOChipGroup(chip_path, pins));
+        if (!group_->setup()) {
+            fprintf(stderr, "⚠ GPIO character device %s unavailable\n", chip_path.c_str());
+        }
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < configs_.size(); i++) {
+        GPIOBackend* backend = use_chip ? group_->line(i) : createGPIOBackend(backend_spec_, configs_[i].pin);
+        buttons_.push_back(std::unique_ptr<GPIOButton>(new GPIOButton(backend, timing_)));
+        if (!buttons_.back()->setup()) {
+            fprintf(stderr, "Failed to setup GPIO %d (%s)\n", configs_[i].pin, configs_[i].name.c_str());
+            ok = false;
+        }
+    }
+
+    // Failed group: every line has fallen back to its own backend
+    if (group_ && group_->fd() < 0) group_.reset();
+    return ok;
+}
+
+GPIOButton* InputManager::button(const std::string& name) {
+    for (size_t i = 0; i < configs_.size() && i < buttons_.size(); i++) {
+        if (configs_[i].name == name) return buttons_[i].get();
+    }
+    return nullptr;
+}
+
+void InputManager::onDispatch(std::function<void(const ButtonEvent&)> observer) {
+    for (size_t i = 0; i < buttons_.size(); i++) {
+        buttons_[i]->onDispatch(observer);
+    }
+}
+
+void InputManager::setNotifyFd(int fd) {
+    notify_fd_ = fd;
+}
+
+bool InputManager::start() {
+    if (running_ || buttons_.empty()) return false;
+
+    // Collect the fds that signal edges for every button
+    std::vector<int> fds;
+    if (group_) {
+        fds.push_back(group_->fd());
+    } else {
+        for (size_t i = 0; i < buttons_.size(); i++) {
+            int fd = buttons_[i]->backend()->eventFd();
+            if (fd < 0) return false; // At least one backend must be polled
+            fds.push_back(fd);
+        }
+    }
+
+    stop_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (stop_fd_ < 0) return false;
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        close(stop_fd_);
+        stop_fd_ = -1;
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    fds.push_back(stop_fd_);
+    for (size_t i = 0; i < fds.size(); i++) {
+        ev.data.fd = fds[i];
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fds[i], &ev);
+    }
+
+    for (size_t i = 0; i < buttons_.size(); i++) {
+        buttons_[i]->setQueued(true);
+    }
+    running_ = true;
+    thread_ = std::thread(&InputManager::threadLoop, this);
+    return true;
+}
+
+void InputManager::stop() {
+    if (!running_) return;
+
+    uint64_t one = 1;
+    if (write(stop_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+    thread_.join();
+    close(epoll_fd_);
+    close(stop_fd_);
+    epoll_fd_ = -1;
+    stop_fd_ = -1;
+    running_ = false;
+
+    for (size_t i = 0; i < buttons_.size(); i++) {
+        buttons_[i]->setQueued(false);
+    }
+}
+
+void InputManager::poll(long current_time_ms) {
+    if (running_) {
+        // Threaded mode: the input thread already classified the gestures
+        for (size_t i = 0; i < buttons_.size(); i++) {
+            buttons_[i]->poll(current_time_ms);
+        }
+        return;
+    }
+
+    process(current_time_ms);
+}
+
+void InputManager::threadLoop() {
+    for (;;) {
+        // Sleep until the next edge, or until the earliest gesture deadline
+        int timeout_ms = -1;
+        for (size_t i = 0; i < buttons_.size(); i++) {
+            long deadline = buttons_[i]->nextDeadline();
+            if (deadline < 0) continue;
+
+            long remaining = deadline - monotonicMs();
+            int wait_ms = remaining > 0 ? static_cast<int>(remaining) : 0;
+            if (timeout_ms < 0 || wait_ms < timeout_ms) timeout_ms = wait_ms;
+        }
+
+        struct epoll_event ready[8];
+        int n = epoll_wait(epoll_fd_, ready, 8, timeout_ms);
+        if (n < 0 && errno != EINTR) break;
+
+        bool stopping = false;
+        for (int i = 0; i < n; i++) {
+            if (ready[i].data.fd == stop_fd_) stopping = true;
+        }
+        if (stopping) break;
+
+        // Edges carry their own timestamps; a timeout fires due gestures
+        process(monotonicMs());
+
+        // Wake the render loop if there is something to dispatch
+        if (notify_fd_ < 0) continue;
+        for (size_t i = 0; i < buttons_.size(); i++) {
+            if (!buttons_[i]->hasQueuedEvents()) continue;
+
+            uint64_t one = 1;
+            if (write(notify_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+            break;
+        }
+    }
+}
+
+void InputManager::process(long current_time_ms) {
+    // One batched read of every line, then the per-line state machines
+    if (group_) group_->refresh();
+    for (size_t i = 0; i < buttons_.size(); i++) {
+        buttons_[i]->process(current_time_ms);
+    }
+}
+
+const char* InputManager::backendName() const {
+    if (group_) return "gpiochip";
+    if (!buttons_.empty()) return buttons_[0]->backend()->name();
+    return backend_spec_.c_str();
+}
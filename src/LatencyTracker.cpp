@@ -0,0 +1,53 @@
+#include "LatencyTracker.h"
+
+LatencyTracker::LatencyTracker()
+    : pending_(false), composed_(false), edge_us_(0), dispatch_us_(0), composed_us_(0) {}
+
+void LatencyTracker::inputDispatched(long edge_ms, int64_t now_us) {
+    // Several inputs in one frame share its photons: keep the oldest
+    if (pending_) return;
+
+    pending_ = true;
+    composed_ = false;
+    edge_us_ = static_cast<int64_t>(edge_ms) * 1000;
+    dispatch_us_ = now_us;
+}
+
+void LatencyTracker::frameComposed(int64_t now_us) {
+    if (!pending_ || composed_) return;
+
+    composed_ = true;
+    composed_us_ = now_us;
+}
+
+void LatencyTracker::framePresented(int64_t now_us) {
+    if (!pending_ || !composed_) return;
+
+    input_.record(dispatch_us_ - edge_us_);
+    compose_.record(composed_us_ - dispatch_us_);
+    swap_.record(now_us - composed_us_);
+    total_.record(now_us - edge_us_);
+    pending_ = false;
+}
+
+void LatencyTracker::report(FILE* out) const {
+    const struct {
+        const char* name;
+        const Histogram* histogram;
+    } spans[] = {
+        {"edge->dispatch", &input_},
+        {"dispatch->composed", &compose_},
+        {"composed->swapped", &swap_},
+        {"edge->photon", &total_},
+    };
+
+    fprintf(out, "⏱  Input latency (%llu inputs, ms):\n", static_cast<unsigned long long>(total_.count()));
+    fprintf(out, "    %-20s %8s %8s %8s %8s\n", "span", "p50", "p95", "p99", "max");
+    for (size_t i = 0; i < sizeof(spans) / sizeof(spans[0]); i++) {
+        const Histogram& h = *spans[i].histogram;
+        fprintf(out, "    %-20s %8.2f %8.2f %8.2f %8.2f\n", spans[i].name,
+                h.percentile(50) / 1000.0, h.percentile(95) / 1000.0,
+                h.percentile(99) / 1000.0, h.max() / 1000.0);
+    }
+    fflush(out);
+}
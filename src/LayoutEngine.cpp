@@ -0,0 +1,153 @@
+#include "LayoutEngine.h"
+
+LayoutEngine::LayoutEngine(const Config& config, const BitmapFont& date_font, const BitmapFont& time_font,
+                           TextMeasurer& measurer, int width, int height)
+    : config_(config), date_font_(date_font), time_font_(time_font), measurer_(measurer),
+      width_(width), height_(height), clock_valid_(false), generation_(0), time_run_(-1), time_width_(0),
+      show_date_(false), show_time_(false), date_ignore_descenders_(false), time_ignore_descenders_(false),
+      spacing_(0), message_valid_(false), message_font_(nullptr), message_y_(0) {}
+
+const Layout& LayoutEngine::clock(const char* date, const char* time) {
+    int time_width = config_.showTime ? measurer_.width(time_font_, time) : 0;
+
+    // Reuse the cached positions while none of their inputs changed
+    bool valid = clock_valid_ &&
+                 show_date_ == config_.showDate && show_time_ == config_.showTime &&
+                 date_ignore_descenders_ == config_.dateIgnoreDescenders &&
+                 time_ignore_descenders_ == config_.timeIgnoreDescenders &&
+                 spacing_ == config_.dateTimeSpacing && date_wrap_ == config_.dateWrap &&
+                 (!config_.showDate || date_ == date) &&
+                 (!config_.showTime || time_width_ == time_width);
+    if (!valid) {
+        layoutClock(date, time, time_width);
+    } else if (time_run_ >= 0 && clock_.runs[time_run_].text != time) {
+        // Same width: only the digits changed
+        clock_.runs[time_run_].text = time;
+    }
+    return clock_;
+}
+
+const Layout& LayoutEngine::centered(const BitmapFont& font, const char* text, int y) {
+    if (message_valid_ && message_font_ == &font && message_y_ == y && message_.runs[0].text == text) {
+        return message_;
+    }
+
+    message_.runs.clear();
+    addRun(message_, font, (width_ - measurer_.width(font, text)) / 2, y, text);
+    message_valid_ = true;
+    message_font_ = &font;
+    message_y_ = y;
+    return message_;
+}
+
+int LayoutEngine::timeRun() const {
+    return time_run_;
+}
+
+unsigned LayoutEngine::generation() const {
+    return generation_;
+}
+
+void LayoutEngine::layoutClock(const char* date, const char* time, int time_width) {
+    clock_.runs.clear();
+    time_run_ = -1;
+    generation_++;
+
+    if (config_.showDate && config_.showTime) {
+        // Show both date and time
+        int date_width = measurer_.width(date_font_, date);
+
+        // Get font metrics
+        int date_height = date_font_.height();
+        int time_height = time_font_.height();
+        int date_baseline = date_font_.baseline();
+        int time_baseline = time_font_.baseline();
+
+        // Calculate visual heights based on ignoreDescenders flags
+        // If ignoring descenders (for uppercase/numbers only), use only ascent
+        // Otherwise use full font height
+        int date_visual_height = config_.dateIgnoreDescenders ? date_baseline : date_height;
+        int time_visual_height = config_.timeIgnoreDescenders ? time_baseline : time_height;
+
+        // Use configured spacing, but clamp if needed to fit on display
+        int spacing = config_.dateTimeSpacing;
+        int total_height = date_visual_height + spacing + time_visual_height;
+        if (total_height > height_) {
+            // Clamp spacing to fit
+            spacing = height_ - date_visual_height - time_visual_height;
+            if (spacing < 0) spacing = 0;  // Minimum spacing
+            total_height = date_visual_height + spacing + time_visual_height;
+        }
+
+        // Center the visible content vertically
+        int start_y = (height_ - total_height) / 2;
+
+        // Calculate X positions (horizontal centering)
+        int date_x = (width_ - date_width) / 2;
+        int time_x = (width_ - time_width) / 2;
+
+        // Calculate Y positions (baseline positions for DrawText)
+        int date_y = start_y + date_baseline;
+        int time_y = start_y + date_visual_height + spacing + time_baseline;
+
+        addRun(clock_, date_font_, date_x, date_y, date);
+        time_run_ = clock_.runs.size();
+        addRun(clock_, time_font_, time_x, time_y, time);
+    } else if (config_.showDate && !config_.showTime) {
+        // Show only date (centered vertically, with word wrap if needed)
+        int date_width = measurer_.width(date_font_, date);
+
+        if (date_width <= width_) {
+            // Date fits in one line - center it
+            int date_x = (width_ - date_width) / 2;
+            int date_y = (height_ / 2) + (date_font_.baseline() / 2);
+            addRun(clock_, date_font_, date_x, date_y, date);
+        } else {
+            wrapDate(date);
+        }
+    } else if (!config_.showDate && config_.showTime) {
+        // Show only time (centered horizontally and vertically)
+        int time_x = (width_ - time_width) / 2;
+        int time_y = (height_ / 2) + (time_font_.baseline() / 2);
+        time_run_ = clock_.runs.size();
+        addRun(clock_, time_font_, time_x, time_y, time);
+    }
+    // If neither is shown (shouldn't happen due to validation), the layout is empty
+
+    clock_valid_ = true;
+    date_ = date;
+    time_width_ = time_width;
+    show_date_ = config_.showDate;
+    show_time_ = config_.showTime;
+    date_ignore_descenders_ = config_.dateIgnoreDescenders;
+    time_ignore_descenders_ = config_.timeIgnoreDescenders;
+    spacing_ = config_.dateTimeSpacing;
+    date_wrap_ = config_.dateWrap;
+}
+
+void LayoutEngine::wrapDate(const char* date) {
+    // Date too wide - wrap on spaces (line ranges into the date string)
+    int lines = wrap_.wrap(measurer_, date_font_, date, width_, WordWrap::parseMode(config_.dateWrap.c_str()));
+
+    // Calculate total height and center vertically
+    int date_height = date_font_.height();
+    int total_height = lines * date_height;
+    int start_y = (height_ - total_height) / 2;
+
+    // Each line centered
+    for (int i = 0; i < lines; i++) {
+        const WrapLine& line = wrap_.line(i);
+        int line_x = (width_ - line.width) / 2;
+        int line_y = start_y + (i * date_height) + date_font_.baseline();
+        addRun(clock_, date_font_, line_x, line_y, std::string(date + line.offset, line.length));
+    }
+}
+
+void LayoutEngine::addRun(Layout& layout, const BitmapFont& font, int x, int y, const std::string& text) {
+    TextRun run;
+    run.font = &font;
+    run.x = x;
+    run.y = y;
+    run.text = text;
+    layout.runs.push_back(run);
+}
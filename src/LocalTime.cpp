@@ -0,0 +1,213 @@
+#include "LocalTime.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <unistd.h>
+#include <sys/inotify.h>
+
+// Days since 1970-01-01 of a proleptic Gregorian date (month 1-12)
+static long daysFromCivil(long y, int m, int d) {
+    y -= m <= 2;
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Whether two probes of localtime_r() belong to the same offset period
+static bool sameOffset(const struct tm& a, const struct tm& b) {
+    return a.tm_gmtoff == b.tm_gmtoff && a.tm_isdst == b.tm_isdst &&
+           strcmp(a.tm_zone ? a.tm_zone : "", b.tm_zone ? b.tm_zone : "") == 0;
+}
+
+LocalTime::LocalTime()
+    : valid_from_(0), valid_until_(0), gmtoff_(0), isdst_(0), exact_(true), warned_(false),
+      tm_time_(-1), reloads_(0), inotify_fd_(-1), watches_(0) {
+    zone_[0] = '\0';
+    memset(&tm_, 0, sizeof(tm_));
+}
+
+LocalTime::~LocalTime() {
+    if (inotify_fd_ >= 0) close(inotify_fd_);
+}
+
+bool LocalTime::setup() {
+    // glibc only re-reads a zone named by TZ when TZ itself changes, and
+    // changing it would race with other threads reading the environment:
+    // only the default zone (TZ unset) follows its file
+    std::string path = "/etc/localtime";
+    if (getenv("TZ")) return false;
+
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) return false;
+
+    // /etc/localtime is usually a symlink replaced on zone changes; its target
+    // is rewritten by tzdata upgrades
+    bool watching = watchFile(path);
+    char target[PATH_MAX];
+    if (realpath(path.c_str(), target) && path != target) watching |= watchFile(target);
+
+    if (!watching) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+    return watching;
+}
+
+const struct tm& LocalTime::now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    time_t t = ts.tv_sec;
+    if (t == tm_time_) return tm_;
+
+    // Once per second: a changed zone file invalidates the cached period
+    if (inotify_fd_ >= 0 && zoneChanged()) {
+        reloadZone();
+        valid_from_ = valid_until_ = 0;
+        warned_ = false;
+    }
+    return at(t);
+}
+
+const struct tm& LocalTime::at(time_t t) {
+    if (t < valid_from_ || t >= valid_until_) reload(t);
+
+    if (exact_) {
+        convert(t);
+    } else {
+        localtime_r(&t, &tm_);
+    }
+    tm_time_ = t;
+    return tm_;
+}
+
+time_t LocalTime::nextTransition() const {
+    return valid_until_;
+}
+
+unsigned long LocalTime::reloads() const {
+    return reloads_;
+}
+
+bool LocalTime::exact() const {
+    return exact_;
+}
+
+void LocalTime::reload(time_t t) {
+    struct tm probe;
+    localtime_r(&t, &probe);
+    gmtoff_ = probe.tm_gmtoff;
+    isdst_ = probe.tm_isdst;
+    snprintf(zone_, sizeof(zone_), "%s", probe.tm_zone ? probe.tm_zone : "");
+    reloads_++;
+
+    // Coarse daily scan for the next offset change, then bisect to the second
+    valid_from_ = t;
+    valid_until_ = t + static_cast<time_t>(LOCAL_TIME_SCAN_DAYS) * 86400;
+    struct tm ahead;
+    for (int day = 1; day <= LOCAL_TIME_SCAN_DAYS; day++) {
+        time_t u = t + static_cast<time_t>(day) * 86400;
+        localtime_r(&u, &ahead);
+        if (sameOffset(probe, ahead)) continue;
+
+        time_t lo = u - 86400, hi = u;   // lo: same offset, hi: changed
+        while (hi - lo > 1) {
+            time_t mid = lo + (hi - lo) / 2;
+            localtime_r(&mid, &ahead);
+            if (sameOffset(probe, ahead)) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        valid_until_ = hi;
+        break;
+    }
+
+    // Leap-second zones count seconds differently: keep using localtime_r()
+    convert(t);
+    exact_ = tm_.tm_sec == probe.tm_sec && tm_.tm_min == probe.tm_min && tm_.tm_hour == probe.tm_hour &&
+             tm_.tm_mday == probe.tm_mday && tm_.tm_mon == probe.tm_mon && tm_.tm_year == probe.tm_year;
+    if (!exact_ && !warned_) {
+        fprintf(stderr, "⚠ Local time arithmetic differs from localtime_r(), using localtime_r()\n");
+        warned_ = true;
+    }
+}
+
+void LocalTime::convert(time_t t) {
+    long long local = static_cast<long long>(t) + gmtoff_;
+    long long days = local / 86400;
+    long secs = static_cast<long>(local % 86400);
+    if (secs < 0) {
+        secs += 86400;
+        days--;
+    }
+
+    // Civil date from days since the epoch (Howard Hinnant's algorithm)
+    long z = static_cast<long>(days) + 719468;
+    long era = (z >= 0 ? z : z - 146096) / 146097;
+    long doe = z - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    int mday = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    int mon = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    long year = yoe + era * 400 + (mon <= 2);
+
+    tm_.tm_sec = static_cast<int>(secs % 60);
+    tm_.tm_min = static_cast<int>(secs / 60 % 60);
+    tm_.tm_hour = static_cast<int>(secs / 3600);
+    tm_.tm_mday = mday;
+    tm_.tm_mon = mon - 1;
+    tm_.tm_year = static_cast<int>(year - 1900);
+    tm_.tm_wday = static_cast<int>(((days + 4) % 7 + 7) % 7);   // 1970-01-01 was a Thursday
+    tm_.tm_yday = static_cast<int>(days - daysFromCivil(year, 1, 1));
+    tm_.tm_isdst = isdst_;
+    tm_.tm_gmtoff = gmtoff_;
+    tm_.tm_zone = zone_;
+}
+
+bool LocalTime::zoneChanged() {
+    // Events are variable-length; a buffer of a few is enough per read
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool changed = false;
+    ssize_t n;
+    while ((n = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + n;) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+            for (int i = 0; i < watches_; i++) {
+                if (event->wd == watch_wd_[i] && event->len > 0 && watch_name_[i] == event->name) changed = true;
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    if (changed) printf("🕒 Time zone file changed, reloading\n");
+    return changed;
+}
+
+void LocalTime::reloadZone() {
+    // With TZ unset, tzset() always re-stats /etc/localtime and reloads it
+    // if it was replaced. It holds glibc's zone lock, so localtime_r() on
+    // other threads sees the old or the new zone, and the environment is
+    // left alone.
+    tzset();
+}
+
+bool LocalTime::watchFile(const std::string& path) {
+    if (watches_ >= LOCAL_TIME_MAX_WATCHES) return false;
+
+    size_t slash = path.rfind('/');
+    std::string dir = slash == 0 ? "/" : path.substr(0, slash);
+    std::string name = path.substr(slash + 1);
+
+    int wd = inotify_add_watch(inotify_fd_, dir.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+    if (wd < 0) return false;
+
+    watch_wd_[watches_] = wd;
+    watch_name_[watches_] = name;
+    watches_++;
+    return true;
+}
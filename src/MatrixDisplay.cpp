@@ -0,0 +1,67 @@
+#include "MatrixDisplay.h"
+#include <cstdio>
+
+using namespace rgb_matrix;
+
+MatrixDisplay::MatrixDisplay(int width, int height, int brightness)
+    : width_(width), height_(height), brightness_(brightness), matrix_(nullptr), offscreen_(nullptr) {}
+
+MatrixDisplay::~MatrixDisplay() {
+    delete matrix_;
+}
+
+bool MatrixDisplay::setup() {
+    RGBMatrix::Options matrix_options;
+    RuntimeOptions runtime_opt;
+
+    matrix_options.rows = height_;
+    matrix_options.cols = width_;
+    matrix_options.chain_length = 1;
+    matrix_options.parallel = 1;
+    matrix_options.hardware_mapping = "adafruit-hat";
+    matrix_options.led_rgb_sequence = "RBG";
+    runtime_opt.gpio_slowdown = 4;
+    runtime_opt.drop_privileges = 0; // Don't drop privileges - we need root for config file writes
+    matrix_options.brightness = brightness_;
+
+    matrix_ = RGBMatrix::CreateFromOptions(matrix_options, runtime_opt);
+    if (matrix_ == NULL) {
+        fprintf(stderr, "Failed to create matrix\n");
+        return false;
+    }
+
+    offscreen_ = wrap(matrix_->CreateFrameCanvas());
+    return true;
+}
+
+int MatrixDisplay::width() const {
+    return width_;
+}
+
+int MatrixDisplay::height() const {
+    return height_;
+}
+
+DisplayCanvas* MatrixDisplay::offscreen() {
+    return offscreen_;
+}
+
+void MatrixDisplay::swap() {
+    offscreen_ = wrap(matrix_->SwapOnVSync(offscreen_->canvas));
+}
+
+void MatrixDisplay::setBrightness(uint8_t percent) {
+    matrix_->SetBrightness(percent);
+}
+
+void MatrixDisplay::clear() {
+    matrix_->Clear();
+}
+
+MatrixDisplay::Canvas* MatrixDisplay::wrap(FrameCanvas* canvas) {
+    for (size_t i = 0; i < canvases_.size(); i++) {
+        if (canvases_[i]->canvas == canvas) return canvases_[i].get();
+    }
+    canvases_.push_back(std::unique_ptr<Canvas>(new Canvas(canvas)));
+    return canvases_.back().get();
+}
@@ -0,0 +1,29 @@
+#include "PinctrlBackend.h"
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+PinctrlBackend::PinctrlBackend(int pin) : pin_(pin) {}
+
+bool PinctrlBackend::setup() {
+    char cmd[64];
+    snprintf(cmd, sizeof(cmd), "pinctrl set %d ip pu", pin_);
+    return system(cmd) == 0;
+}
+
+int PinctrlBackend::read() {
+    char cmd[64];
+    snprintf(cmd, sizeof(cmd), "pinctrl lev %d 2>/dev/null", pin_);
+
+    FILE* pipe = popen(cmd, "r");
+    if (!pipe) return -1;
+
+    char buffer[128];
+    if (fgets(buffer, sizeof(buffer), pipe)) {
+        pclose(pipe);
+        return (strchr(buffer, '1') != NULL) ? 1 : 0;
+    }
+
+    pclose(pipe);
+    return -1;
+}
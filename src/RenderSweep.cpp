@@ -0,0 +1,173 @@
+#include "RenderSweep.h"
+#include "BitmapFont.h"
+#include "Config.h"
+#include "FrameBuffer.h"
+#include "LayoutEngine.h"
+#include "MonotonicClock.h"
+#include "Scene.h"
+#include "TextMeasurer.h"
+#include "TimeFormat.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <locale.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+RenderSweep::RenderSweep(const std::string& font_dir, const std::string& golden_dir, int width, int height, bool update)
+    : font_dir_(font_dir), golden_dir_(golden_dir), width_(width), height_(height), update_(update) {
+    if (!golden_dir_.empty() && golden_dir_[golden_dir_.size() - 1] != '/') golden_dir_ += '/';
+}
+
+int RenderSweep::run() {
+    static const Case cases[] = {
+        { "datetime",      true,  true,  true,  1, "%a %d %b",       "greedy" },
+        { "datetime-desc", true,  true,  false, 4, "%a %d %b",       "greedy" },
+        { "date-greedy",   true,  false, true,  1, "%A %d %B %Y",    "greedy" },
+        { "date-balanced", true,  false, true,  1, "%A %d %B %Y",    "balanced" },
+        { "time",          false, true,  true,  1, "%a %d %b",       "greedy" },
+    };
+    const size_t case_count = sizeof(cases) / sizeof(cases[0]);
+    const RGBColor color(255, 128, 0);     // No two channels alike: catches swapped channels
+
+    // Every bundled font, in a stable order
+    std::vector<std::string> fonts;
+    DIR* dir = opendir(font_dir_.c_str());
+    if (!dir) {
+        fprintf(stderr, "Failed to open %s: %s\n", font_dir_.c_str(), strerror(errno));
+        return -1;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".bdf") == 0) fonts.push_back(name);
+    }
+    closedir(dir);
+    std::sort(fonts.begin(), fonts.end());
+
+    // Fixed instant, independent of the time zone and locale
+    std::string previous_locale = setlocale(LC_TIME, NULL);
+    setlocale(LC_TIME, "C");
+    time_t instant = RENDER_SWEEP_TIME;
+    struct tm tm_fixed;
+    gmtime_r(&instant, &tm_fixed);
+
+    int mismatches = 0, updated = 0, skipped = 0, frames = 0;
+    int64_t load_ns = 0, render_ns = 0;
+    int64_t start_ns = monotonicNs();
+
+    for (size_t f = 0; f < fonts.size(); f++) {
+        BitmapFont font;
+        int64_t t0 = monotonicNs();
+        bool loaded = font.load((font_dir_ + fonts[f]).c_str());
+        load_ns += monotonicNs() - t0;
+        if (!loaded) {
+            fprintf(stderr, "⚠ Couldn't load %s, skipped\n", fonts[f].c_str());
+            skipped++;
+            continue;
+        }
+        std::string stem = fonts[f].substr(0, fonts[f].size() - 4);
+
+        for (size_t c = 0; c < case_count; c++) {
+            const Case& sc = cases[c];
+            Config config;
+            config.showDate = sc.show_date;
+            config.showTime = sc.show_time;
+            config.dateIgnoreDescenders = sc.ignore_descenders;
+            config.timeIgnoreDescenders = sc.ignore_descenders;
+            config.dateTimeSpacing = sc.spacing;
+            config.dateWrap = sc.wrap;
+
+            // Cold render: fresh caches, as after a config change
+            t0 = monotonicNs();
+            TextMeasurer measurer;
+            LayoutEngine layout_engine(config, font, font, measurer, width_, height_);
+            TimeFormat date_format(sc.date_format, true);
+            TimeFormat time_format(config.timeFormat);
+            date_format.update(tm_fixed);
+            time_format.update(tm_fixed);
+            Scene scene(width_, height_);
+            LayoutNode* node = new LayoutNode();
+            scene.root().add(node);
+            node->set(layout_engine.clock(date_format.text(), time_format.text()), color, layout_engine.timeRun());
+            FrameBuffer framebuffer(width_, height_);
+            scene.compose(framebuffer);
+            render_ns += monotonicNs() - t0;
+            frames++;
+
+            bool written = false;
+            if (!check(stem + "-" + sc.name + ".ppm", framebuffer.pixels(), written)) mismatches++;
+            if (written) updated++;
+        }
+    }
+
+    setlocale(LC_TIME, previous_locale.c_str());
+
+    int64_t total_ns = monotonicNs() - start_ns;
+    printf("🧪 Render sweep: %d frames (%zu fonts x %zu layouts), %d mismatched, %d goldens written, %d fonts skipped\n",
+           frames, fonts.size() - skipped, case_count, mismatches, updated, skipped);
+    printf("    font loading  %8.2f ms\n", load_ns / 1e6);
+    printf("    rendering     %8.2f ms  (%.1f us/frame, %.0f frames/s)\n", render_ns / 1e6,
+           frames > 0 ? render_ns / 1e3 / frames : 0.0, render_ns > 0 ? frames * 1e9 / render_ns : 0.0);
+    printf("    total         %8.2f ms\n", total_ns / 1e6);
+    return mismatches;
+}
+
+bool RenderSweep::check(const std::string& name, const uint8_t* rgb, bool& written) {
+    std::string path = golden_dir_ + name;
+    std::string actual = encode(rgb);
+    written = false;
+
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) {
+        if (update_) return written = writeGolden(path, actual);
+        printf("❌ %s: no golden frame (run with --update-goldens to record it)\n", name.c_str());
+        return false;
+    }
+    std::stringstream golden;
+    golden << in.rdbuf();
+    if (golden.str() == actual) return true;
+    if (update_) {
+        in.close();
+        printf("✏  %s: golden updated\n", name.c_str());
+        return written = writeGolden(path, actual);
+    }
+
+    // Report the first differing pixel (or a format mismatch)
+    const std::string& expected = golden.str();
+    size_t header = actual.size() - width_ * height_ * 3;
+    if (expected.size() != actual.size() || expected.compare(0, header, actual, 0, header) != 0) {
+        printf("❌ %s: golden is not a %dx%d PPM\n", name.c_str(), width_, height_);
+        return false;
+    }
+    int differing = 0, first = -1;
+    for (int i = 0; i < width_ * height_; i++) {
+        if (memcmp(&expected[header + i * 3], &actual[header + i * 3], 3) != 0) {
+            if (first < 0) first = i;
+            differing++;
+        }
+    }
+    printf("❌ %s: %d pixels differ (first at %d,%d)\n", name.c_str(), differing, first % width_, first / width_);
+    return false;
+}
+
+bool RenderSweep::writeGolden(const std::string& path, const std::string& ppm) {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    out.write(ppm.data(), ppm.size());
+    if (!out) {
+        fprintf(stderr, "Failed to write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string RenderSweep::encode(const uint8_t* rgb) const {
+    char header[32];
+    int length = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", width_, height_);
+    std::string ppm(header, length);
+    ppm.append(reinterpret_cast<const char*>(rgb), width_ * height_ * 3);
+    return ppm;
+}
@@ -0,0 +1,170 @@
+#include "Renderer.h"
+#include "MonotonicClock.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+Renderer::Renderer(Display* display, FrameBuffer& framebuffer, LayoutEngine& layout, const BitmapFont& message_font)
+    : display_(display), framebuffer_(framebuffer), layout_(layout), message_font_(message_font),
+      scene_(framebuffer.width(), framebuffer.height()), scene_buffer_(framebuffer.width(), framebuffer.height()),
+      text_node_(new LayoutNode()), compositor_(framebuffer.width(), framebuffer.height()),
+      snake_drawn_(false), recorder_(nullptr), stats_(nullptr), running_(false), stopping_(false), report_requested_(false), wake_fd_(-1),
+      last_input_us_(0), input_taken_(0), drawn_(0) {
+    scene_.root().add(text_node_);
+    message_layer_ = compositor_.addLayer();
+    snake_layer_ = compositor_.addLayer();
+}
+
+Renderer::~Renderer() {
+    stop();
+}
+
+void Renderer::setRecorder(FrameRecorder* recorder) {
+    recorder_ = recorder;
+}
+
+void Renderer::setStats(FrameStats* stats) {
+    stats_ = stats;
+}
+
+bool Renderer::start() {
+    if (running_) return true;
+
+    wake_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        perror("eventfd");
+        return false;
+    }
+    stopping_ = false;
+    running_ = true;
+    thread_ = std::thread(&Renderer::threadLoop, this);
+    return true;
+}
+
+void Renderer::stop() {
+    if (!running_) return;
+
+    stopping_ = true;
+    uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+    thread_.join();
+    close(wake_fd_);
+    wake_fd_ = -1;
+    running_ = false;
+}
+
+FrameState& Renderer::next() {
+    return frames_.back();
+}
+
+void Renderer::publish() {
+    frames_.publish();
+    uint64_t one = 1;
+    if (wake_fd_ >= 0 && write(wake_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+}
+
+int64_t Renderer::inputTaken() const {
+    return input_taken_.load(std::memory_order_acquire);
+}
+
+unsigned long Renderer::framesDrawn() const {
+    return drawn_.load(std::memory_order_relaxed);
+}
+
+void Renderer::requestReport() {
+    report_requested_ = true;
+    uint64_t one = 1;
+    if (wake_fd_ >= 0 && write(wake_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+}
+
+void Renderer::report(FILE* out) const {
+    latency_.report(out);
+}
+
+void Renderer::threadLoop() {
+    while (!stopping_) {
+        // Sleep until something was published; several publishes = one wake
+        uint64_t count;
+        if (read(wake_fd_, &count, sizeof(count)) < 0 && errno != EINTR) break;
+
+        if (frames_.update()) render(frames_.front());
+        if (report_requested_.exchange(false)) latency_.report(stdout);
+    }
+}
+
+void Renderer::render(const FrameState& state) {
+    int64_t start_us = monotonicUs();
+
+    // An input is carried by every frame until the logic thread sees it taken
+    if (state.input_dispatch_us != 0 && state.input_dispatch_us != last_input_us_) {
+        latency_.inputDispatched(state.input_edge_ms, state.input_dispatch_us);
+        last_input_us_ = state.input_dispatch_us;
+        input_taken_.store(last_input_us_, std::memory_order_release);
+    }
+
+    // Update the scene nodes; only what they damaged is recomposed
+    const Layout& layout = state.content == SHOW_CLOCK
+        ? layout_.clock(state.date.c_str(), state.time.c_str())
+        : layout_.centered(message_font_, state.label.c_str(), 20);
+    text_node_->set(layout, state.color, state.content == SHOW_CLOCK ? layout_.timeRun() : -1);
+    int64_t layout_us = monotonicUs();
+    scene_.compose(scene_buffer_);
+    int64_t draw_us = monotonicUs();
+
+    // Message layer: opaque black behind the text, redrawn when it changes
+    const RGBColor& overlay = state.message_color;
+    if (state.message_opacity > 0 && (state.message != message_layer_text_ || overlay.r != message_layer_color_.r ||
+                                      overlay.g != message_layer_color_.g || overlay.b != message_layer_color_.b)) {
+        const Layout& message_layout = layout_.centered(message_font_, state.message.c_str(), 20);
+        compositor_.clear(message_layer_, RGBColor(), 255);
+        for (size_t i = 0; i < message_layout.runs.size(); i++) {
+            const TextRun& run = message_layout.runs[i];
+            compositor_.drawText(message_layer_, *run.font, run.x, run.y, overlay, run.text.c_str());
+        }
+        message_layer_text_ = state.message;
+        message_layer_color_ = overlay;
+    }
+    compositor_.setOpacity(message_layer_, state.message_opacity);
+
+    // Snake layer on top of everything
+    if (!state.snake.empty() || snake_drawn_) {
+        compositor_.clear(snake_layer_);
+        for (size_t i = 0; i < state.snake.size(); i++) {
+            compositor_.setPixel(snake_layer_, state.snake[i].first.x, state.snake[i].first.y, state.snake[i].second);
+        }
+        snake_drawn_ = !state.snake.empty();
+    }
+
+    // Blend the layers over the scene (only changed pixels reach the framebuffer)
+    compositor_.composite(scene_buffer_.pixels(), framebuffer_);
+    int64_t overlay_us = monotonicUs();
+    if (recorder_) recorder_->record(framebuffer_.pixels(), overlay_us);
+
+    // A brightness change applies to pixels as they are written: rewrite the
+    // whole canvas at the new level (each canvas in turn)
+    DisplayCanvas* canvas = display_->offscreen();
+    if (canvas->brightness() != state.brightness) {
+        canvas->setBrightness(state.brightness);
+        display_->setBrightness(state.brightness);
+        framebuffer_.invalidate();
+    }
+
+    // Bring the offscreen canvas up to date (only the changed area) and swap
+    framebuffer_.transfer(canvas);
+    int64_t composed_us = monotonicUs();
+    latency_.frameComposed(composed_us);
+    display_->swap();
+    int64_t presented_us = monotonicUs();
+    latency_.framePresented(presented_us);
+    drawn_.fetch_add(1, std::memory_order_relaxed);
+
+    if (stats_) {
+        stats_->record(FrameStats::LAYOUT, layout_us - start_us);
+        stats_->record(FrameStats::DRAW, draw_us - layout_us);
+        stats_->record(FrameStats::OVERLAY, overlay_us - draw_us);
+        stats_->record(FrameStats::TRANSFER, composed_us - overlay_us);
+        stats_->record(FrameStats::SWAP, presented_us - composed_us);
+        stats_->record(FrameStats::FRAME, presented_us - start_us);
+    }
+}
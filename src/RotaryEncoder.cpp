@@ -0,0 +1,194 @@
+#include "RotaryEncoder.h"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <linux/gpio.h>
+
+// Quadrature table indexed by (previous AB << 2) | current AB:
+// +1/-1 for a valid transition, 0 for no change or an invalid double step
+static const int QUADRATURE_TABLE[16] = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+RotaryEncoder::RotaryEncoder(const std::string& backend_spec, int pin_a, int pin_b, int steps_per_detent)
+    : backend_spec_(backend_spec), pin_a_(pin_a), pin_b_(pin_b),
+      steps_per_detent_(steps_per_detent > 0 ? steps_per_detent : 1), line_fd_(-1),
+      state_(3), transitions_(0), detents_(0), running_(false), stop_fd_(-1), notify_fd_(-1) {}
+
+RotaryEncoder::~RotaryEncoder() {
+    stop();
+    if (line_fd_ >= 0) close(line_fd_);
+}
+
+bool RotaryEncoder::setup() {
+    std::string chip_path;
+    if (isGPIOChipSpec(backend_spec_, chip_path)) {
+        int chip_fd = open(chip_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (chip_fd >= 0) {
+            struct gpio_v2_line_request req;
+            memset(&req, 0, sizeof(req));
+            req.offsets[0] = pin_a_;
+            req.offsets[1] = pin_b_;
+            req.num_lines = 2;
+            strncpy(req.consumer, "led-clock-encoder", sizeof(req.consumer) - 1);
+            req.config.flags = GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP |
+                               GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+            req.event_buffer_size = 256; // Room for fast spins between thread wakeups
+
+            int ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+            close(chip_fd);
+            if (ret >= 0) {
+                fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
+                line_fd_ = req.fd;
+
+                struct gpio_v2_line_values values;
+                values.bits = 0;
+                values.mask = 3;
+                if (ioctl(line_fd_, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) >= 0) {
+                    state_ = ((values.bits & 1) << 1) | ((values.bits >> 1) & 1);
+                }
+                return true;
+            }
+        }
+        fprintf(stderr, "⚠ GPIO character device %s unavailable for encoder, falling back to pinctrl\n", chip_path.c_str());
+        backend_a_.reset(createGPIOBackend("pinctrl", pin_a_));
+        backend_b_.reset(createGPIOBackend("pinctrl", pin_b_));
+    } else {
+        backend_a_.reset(createGPIOBackend(backend_spec_, pin_a_));
+        backend_b_.reset(createGPIOBackend(backend_spec_, pin_b_));
+    }
+
+    if (!backend_a_->setup() || !backend_b_->setup()) return false;
+    int a = backend_a_->read();
+    int b = backend_b_->read();
+    if (a >= 0 && b >= 0) state_ = (a << 1) | b;
+    return true;
+}
+
+bool RotaryEncoder::start() {
+    if (line_fd_ < 0 || running_) return false;
+
+    stop_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (stop_fd_ < 0) return false;
+
+    running_ = true;
+    thread_ = std::thread(&RotaryEncoder::threadLoop, this);
+    return true;
+}
+
+void RotaryEncoder::stop() {
+    if (!running_) return;
+
+    uint64_t one = 1;
+    if (write(stop_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+    thread_.join();
+    close(stop_fd_);
+    stop_fd_ = -1;
+    running_ = false;
+}
+
+int RotaryEncoder::poll() {
+    if (!running_) {
+        if (line_fd_ >= 0) {
+            readEvents();
+        } else if (backend_a_) {
+            processBackends();
+        }
+    }
+    return detents_.exchange(0);
+}
+
+void RotaryEncoder::setNotifyFd(int fd) {
+    notify_fd_ = fd;
+}
+
+void RotaryEncoder::feed(int state) {
+    int step = QUADRATURE_TABLE[(state_ << 2) | state];
+    state_ = state;
+    if (step == 0) return;
+
+    // Direction reversal mid-detent restarts the count toward the next detent
+    if ((step > 0) != (transitions_ > 0)) transitions_ = 0;
+    transitions_ += step;
+    if (transitions_ >= steps_per_detent_ || transitions_ <= -steps_per_detent_) {
+        detents_ += transitions_ > 0 ? 1 : -1;
+        transitions_ = 0;
+    }
+}
+
+void RotaryEncoder::readEvents() {
+    // The kernel queues edges of both lines in order: apply each one exactly
+    struct gpio_v2_line_event events[64];
+    ssize_t n;
+    while ((n = ::read(line_fd_, events, sizeof(events))) > 0) {
+        for (size_t i = 0; i < n / sizeof(events[0]); i++) {
+            int bit = static_cast<int>(events[i].offset) == pin_a_ ? 2 : 1;
+            int state = events[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE ? (state_ | bit) : (state_ & ~bit);
+            feed(state);
+        }
+    }
+}
+
+void RotaryEncoder::processBackends() {
+    GPIOEdge edge_a, edge_b;
+    bool has_a = backend_a_->readEdge(edge_a);
+    bool has_b = backend_b_->readEdge(edge_b);
+    while (has_a || has_b) {
+        // Oldest edge first; channel A wins ties
+        if (has_a && (!has_b || edge_a.time_ms <= edge_b.time_ms)) {
+            feed((edge_a.value << 1) | (state_ & 1));
+            has_a = backend_a_->readEdge(edge_a);
+        } else {
+            feed((state_ & 2) | edge_b.value);
+            has_b = backend_b_->readEdge(edge_b);
+        }
+    }
+
+    // Level-only backends: decode from the sampled state
+    int a = backend_a_->read();
+    int b = backend_b_->read();
+    if (a >= 0 && b >= 0) feed((a << 1) | b);
+}
+
+void RotaryEncoder::threadLoop() {
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) return;
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = line_fd_;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, line_fd_, &ev);
+    ev.data.fd = stop_fd_;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, stop_fd_, &ev);
+
+    for (;;) {
+        struct epoll_event ready[2];
+        int n = epoll_wait(epoll_fd, ready, 2, -1);
+        if (n < 0 && errno != EINTR) break;
+
+        bool stopping = false;
+        for (int i = 0; i < n; i++) {
+            if (ready[i].data.fd == stop_fd_) stopping = true;
+        }
+        if (stopping) break;
+
+        readEvents();
+
+        // Wake the render loop once a full detent is pending
+        if (notify_fd_ >= 0 && detents_ != 0) {
+            uint64_t one = 1;
+            if (write(notify_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+        }
+    }
+
+    close(epoll_fd);
+}
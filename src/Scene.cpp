@@ -0,0 +1,448 @@
+#include "Scene.h"
+#include "Utf8.h"
+#include <cstring>
+
+bool SceneRect::intersects(const SceneRect& other) const {
+    return !empty() && !other.empty() &&
+           x0 < other.x1 && other.x0 < x1 && y0 < other.y1 && other.y0 < y1;
+}
+
+SceneRect SceneRect::unite(const SceneRect& other) const {
+    if (empty()) return other;
+    if (other.empty()) return *this;
+    return SceneRect(x0 < other.x0 ? x0 : other.x0, y0 < other.y0 ? y0 : other.y0,
+                     x1 > other.x1 ? x1 : other.x1, y1 > other.y1 ? y1 : other.y1);
+}
+
+// ---------------------------------------------------------------------------
+// SceneNode
+
+SceneNode::SceneNode() : parent_(nullptr), visible_(true), dirty_(true) {}
+
+SceneNode::~SceneNode() {}
+
+void SceneNode::setVisible(bool visible) {
+    if (visible == visible_) return;
+    visible_ = visible;
+    changed();
+}
+
+bool SceneNode::visible() const {
+    return visible_;
+}
+
+const SceneRect& SceneNode::bounds() const {
+    return bounds_;
+}
+
+bool SceneNode::dirty() const {
+    return dirty_;
+}
+
+LayerNode* SceneNode::layer() {
+    return nullptr;
+}
+
+void SceneNode::changed() {
+    dirty_ = true;
+    for (SceneNode* p = parent_; p && !p->dirty_; p = p->parent_) {
+        p->dirty_ = true;
+    }
+}
+
+void SceneNode::setBounds(const SceneRect& bounds) {
+    bounds_ = bounds;
+}
+
+void SceneNode::damage(std::vector<SceneRect>& damage) const {
+    addDamage(damage, drawn_);
+    if (visible_) addDamage(damage, bounds_);
+}
+
+void SceneNode::settle() {
+    drawn_ = visible_ ? bounds_ : SceneRect();
+    dirty_ = false;
+}
+
+void SceneNode::addDamage(std::vector<SceneRect>& damage, const SceneRect& rect) {
+    if (rect.empty()) return;
+
+    // Overlapping rectangles are merged (repeatedly, a merge can reach others)
+    SceneRect merged = rect;
+    for (size_t i = 0; i < damage.size();) {
+        if (damage[i].intersects(merged)) {
+            merged = merged.unite(damage[i]);
+            damage[i] = damage.back();
+            damage.pop_back();
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+    if (damage.size() < SCENE_MAX_DAMAGE) {
+        damage.push_back(merged);
+        return;
+    }
+
+    // List full: grow the entry that grows the least
+    size_t best = 0;
+    int best_growth = -1;
+    for (size_t i = 0; i < damage.size(); i++) {
+        int growth = damage[i].unite(merged).area() - damage[i].area();
+        if (best_growth < 0 || growth < best_growth) {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    damage[best] = damage[best].unite(merged);
+}
+
+// ---------------------------------------------------------------------------
+// TextNode
+
+TextNode::TextNode() : font_(nullptr), x_(0), y_(0), partial_(false) {}
+
+void TextNode::set(const BitmapFont& font, int x, int y, const RGBColor& color, const char* text) {
+    bool same_style = font_ == &font && x == x_ && y == y_ &&
+                      color.r == color_.r && color.g == color_.g && color.b == color_.b;
+    if (same_style && text_ == text) return;
+
+    // Glyph cells of the new text (into the spare buffers: no allocation
+    // once they have grown to the longest text)
+    const char* end = text + strlen(text);
+    std::vector<uint32_t>& cells = next_cells_;
+    std::vector<int>& advances = next_advances_;
+    cells.clear();
+    advances.clear();
+    int width = 0;
+    for (const char* p = text; p < end;) {
+        uint32_t cp = utf8NextCodepoint(p, end);
+        const Glyph* g = font.glyph(cp);
+        cells.push_back(cp);
+        advances.push_back(g ? g->advance : 0);
+        width += advances.back();
+    }
+
+    // Same cells in the same places: damage only the glyphs that changed
+    // (unless the node already needs a full recompose)
+    bool in_place = same_style && advances == advances_ && (!dirty_ || partial_);
+    if (in_place) {
+        int top = y - font.baseline();
+        int pen = x;
+        for (size_t i = 0; i < cells.size(); i++) {
+            if (cells[i] != cells_[i]) {
+                addDamage(changed_cells_, SceneRect(pen, top, pen + advances[i], top + font.height()));
+            }
+            pen += advances[i];
+        }
+    }
+    partial_ = in_place;
+
+    font_ = &font;
+    x_ = x;
+    y_ = y;
+    color_ = color;
+    text_ = text;
+    cells_.swap(cells);
+    advances_.swap(advances);
+    setBounds(SceneRect(x, y - font.baseline(), x + width, y - font.baseline() + font.height()));
+    changed();
+}
+
+void TextNode::render(FrameBuffer& fb) const {
+    if (font_) fb.drawText(*font_, x_, y_, color_, text_.c_str());
+}
+
+void TextNode::damage(std::vector<SceneRect>& damage) const {
+    // A visibility change always redraws the whole text
+    if (partial_ && visible_ && !drawn_.empty()) {
+        for (size_t i = 0; i < changed_cells_.size(); i++) {
+            addDamage(damage, changed_cells_[i]);
+        }
+        return;
+    }
+    SceneNode::damage(damage);
+}
+
+void TextNode::settle() {
+    SceneNode::settle();
+    changed_cells_.clear();
+    partial_ = false;
+}
+
+// ---------------------------------------------------------------------------
+// RectNode
+
+void RectNode::set(int x, int y, int w, int h, const RGBColor& color) {
+    SceneRect bounds(x, y, x + w, y + h);
+    if (bounds.x0 == bounds_.x0 && bounds.y0 == bounds_.y0 && bounds.x1 == bounds_.x1 &&
+        bounds.y1 == bounds_.y1 && color.r == color_.r && color.g == color_.g && color.b == color_.b) {
+        return;
+    }
+    color_ = color;
+    setBounds(bounds);
+    changed();
+}
+
+void RectNode::render(FrameBuffer& fb) const {
+    fb.fillRect(bounds_.x0, bounds_.y0, bounds_.x1 - bounds_.x0, bounds_.y1 - bounds_.y0, color_);
+}
+
+// ---------------------------------------------------------------------------
+// SpriteNode
+
+SpriteNode::SpriteNode() : image_(nullptr) {}
+
+void SpriteNode::set(int x, int y, int w, int h, const uint8_t* rgb) {
+    pixels_.assign(rgb, rgb + w * h * 3);
+    image_ = pixels_.empty() ? nullptr : &pixels_[0];
+    setBounds(SceneRect(x, y, x + w, y + h));
+    changed();
+}
+
+void SpriteNode::show(int x, int y, int w, int h, const uint8_t* rgb) {
+    if (rgb == image_ && x == bounds_.x0 && y == bounds_.y0 && x + w == bounds_.x1 && y + h == bounds_.y1) return;
+    image_ = rgb;
+    setBounds(SceneRect(x, y, x + w, y + h));
+    changed();
+}
+
+void SpriteNode::move(int x, int y) {
+    if (x == bounds_.x0 && y == bounds_.y0) return;
+    setBounds(SceneRect(x, y, x + bounds_.x1 - bounds_.x0, y + bounds_.y1 - bounds_.y0));
+    changed();
+}
+
+void SpriteNode::invalidate() {
+    changed();
+}
+
+void SpriteNode::render(FrameBuffer& fb) const {
+    if (!image_) return;
+    fb.blit(bounds_.x0, bounds_.y0, bounds_.x1 - bounds_.x0, bounds_.y1 - bounds_.y0, image_);
+}
+
+// ---------------------------------------------------------------------------
+// PathNode
+
+void PathNode::set(const std::vector<std::pair<Point, RGBColor> >& pixels) {
+    bool same = pixels.size() == pixels_.size();
+    for (size_t i = 0; same && i < pixels.size(); i++) {
+        const Point& a = pixels[i].first;
+        const Point& b = pixels_[i].first;
+        const RGBColor& ca = pixels[i].second;
+        const RGBColor& cb = pixels_[i].second;
+        same = a.x == b.x && a.y == b.y && ca.r == cb.r && ca.g == cb.g && ca.b == cb.b;
+    }
+    if (same) return;
+
+    pixels_ = pixels;
+    SceneRect bounds;
+    for (size_t i = 0; i < pixels_.size(); i++) {
+        const Point& p = pixels_[i].first;
+        bounds = bounds.unite(SceneRect(p.x, p.y, p.x + 1, p.y + 1));
+    }
+    setBounds(bounds);
+    changed();
+}
+
+void PathNode::render(FrameBuffer& fb) const {
+    for (size_t i = 0; i < pixels_.size(); i++) {
+        fb.setPixel(pixels_[i].first.x, pixels_[i].first.y, pixels_[i].second);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// LayerNode
+
+LayerNode::~LayerNode() {
+    for (size_t i = 0; i < children_.size(); i++) {
+        delete children_[i];
+    }
+}
+
+SceneNode* LayerNode::add(SceneNode* node) {
+    node->parent_ = this;
+    children_.push_back(node);
+    node->changed();
+    return node;
+}
+
+size_t LayerNode::size() const {
+    return children_.size();
+}
+
+SceneNode* LayerNode::child(size_t i) const {
+    return children_[i];
+}
+
+void LayerNode::render(FrameBuffer& fb) const {
+    for (size_t i = 0; i < children_.size(); i++) {
+        if (children_[i]->visible_) children_[i]->render(fb);
+    }
+}
+
+void LayerNode::damage(std::vector<SceneRect>& damage) const {
+    // Shown or hidden as a whole: everything it covers (or covered)
+    if (!visible_ || drawn_.empty()) {
+        SceneNode::damage(damage);
+        return;
+    }
+    for (size_t i = 0; i < children_.size(); i++) {
+        if (children_[i]->dirty_) children_[i]->damage(damage);
+    }
+}
+
+void LayerNode::settle() {
+    // Child layers were brought up to date by compose (updateBounds)
+    for (size_t i = 0; i < children_.size(); i++) {
+        if (children_[i]->dirty_) children_[i]->settle();
+    }
+    SceneNode::settle();
+}
+
+LayerNode* LayerNode::layer() {
+    return this;
+}
+
+void LayerNode::updateBounds() {
+    // A clean child layer keeps its bounds
+    SceneRect bounds;
+    for (size_t i = 0; i < children_.size(); i++) {
+        SceneNode* node = children_[i];
+        LayerNode* layer = node->dirty_ ? node->layer() : nullptr;
+        if (layer) layer->updateBounds();
+        if (node->visible_) bounds = bounds.unite(node->bounds_);
+    }
+    setBounds(bounds);
+}
+
+// ---------------------------------------------------------------------------
+// TimeNode
+
+TimeNode::TimeNode() {
+    text_ = static_cast<TextNode*>(add(new TextNode()));
+}
+
+void TimeNode::set(const BitmapFont& font, int x, int y, const RGBColor& color, const char* text) {
+    // New font or color: every cell shows a new image, even at a reused address
+    bool rebuilt = sprites_.build(font, color);
+
+    const char* end = text + strlen(text);
+    size_t count = 0;
+    bool cached = true;
+    for (const char* p = text; p < end; count++) {
+        if (!sprites_.image(utf8NextCodepoint(p, end))) cached = false;
+    }
+
+    if (!cached) {
+        text_->set(font, x, y, color, text);
+        text_->setVisible(true);
+        count = 0;
+    } else {
+        text_->setVisible(false);
+        while (cells_.size() < count) {
+            cells_.push_back(static_cast<SpriteNode*>(add(new SpriteNode())));
+        }
+        int pen = x;
+        size_t i = 0;
+        for (const char* p = text; p < end; i++) {
+            uint32_t cp = utf8NextCodepoint(p, end);
+            SpriteNode* cell = cells_[i];
+            if (rebuilt) cell->invalidate();
+            cell->show(pen, y + sprites_.top(), sprites_.advance(cp), sprites_.height(), sprites_.image(cp));
+            cell->setVisible(true);
+            pen += sprites_.advance(cp);
+        }
+    }
+    for (size_t i = count; i < cells_.size(); i++) {
+        cells_[i]->setVisible(false);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// LayoutNode
+
+LayoutNode::LayoutNode() {
+    // First child: the opaque digit cells never cover another run's ink
+    time_ = static_cast<TimeNode*>(add(new TimeNode()));
+    time_->setVisible(false);
+}
+
+void LayoutNode::set(const Layout& layout, const RGBColor& color, int time_run) {
+    while (runs_.size() < layout.runs.size()) {
+        runs_.push_back(static_cast<TextNode*>(add(new TextNode())));
+    }
+    for (size_t i = 0; i < runs_.size(); i++) {
+        bool shown = i < layout.runs.size() && static_cast<int>(i) != time_run;
+        if (shown) {
+            const TextRun& run = layout.runs[i];
+            runs_[i]->set(*run.font, run.x, run.y, color, run.text.c_str());
+        }
+        runs_[i]->setVisible(shown);
+    }
+
+    bool time_shown = time_run >= 0 && time_run < static_cast<int>(layout.runs.size());
+    if (time_shown) {
+        const TextRun& run = layout.runs[time_run];
+        time_->set(*run.font, run.x, run.y, color, run.text.c_str());
+    }
+    time_->setVisible(time_shown);
+}
+
+// ---------------------------------------------------------------------------
+// Scene
+
+Scene::Scene(int width, int height) : width_(width), height_(height), full_(true) {}
+
+LayerNode& Scene::root() {
+    return root_;
+}
+
+void Scene::invalidate() {
+    full_ = true;
+}
+
+bool Scene::compose(FrameBuffer& fb) {
+    damage_.clear();
+    SceneRect screen(0, 0, width_, height_);
+    if (root_.dirty_) root_.updateBounds();
+    if (full_) {
+        damage_.push_back(screen);
+    } else if (root_.dirty_) {
+        root_.damage(damage_);
+    }
+    if (root_.dirty_) root_.settle();
+    full_ = false;
+    if (damage_.empty()) return false;
+
+    // Clear each damaged area and draw everything that overlaps it
+    for (size_t i = 0; i < damage_.size(); i++) {
+        SceneRect rect = damage_[i];
+        if (rect.x0 < 0) rect.x0 = 0;
+        if (rect.y0 < 0) rect.y0 = 0;
+        if (rect.x1 > width_) rect.x1 = width_;
+        if (rect.y1 > height_) rect.y1 = height_;
+        if (rect.empty()) continue;
+
+        fb.setClip(rect.x0, rect.y0, rect.x1, rect.y1);
+        fb.fillRect(rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0, RGBColor());
+        renderArea(root_, fb, rect);
+    }
+    fb.resetClip();
+    return true;
+}
+
+void Scene::renderArea(const LayerNode& layer, FrameBuffer& fb, const SceneRect& rect) {
+    for (size_t i = 0; i < layer.children_.size(); i++) {
+        SceneNode* node = layer.children_[i];
+        if (!node->visible_) continue;
+
+        const LayerNode* child_layer = node->layer();
+        if (child_layer) {
+            renderArea(*child_layer, fb, rect);
+        } else if (node->bounds_.intersects(rect)) {
+            node->render(fb);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include "SimulatedBackend.h"
+#include "MonotonicClock.h"
+#include <cstdio>
+#include <cstring>
+
+SimulatedBackend::SimulatedBackend(const std::string& script_path, bool realtime, int pin)
+    : script_path_(script_path), realtime_(realtime), pin_(pin), base_ms_(0), virtual_ms_(0), next_(0) {}
+
+bool SimulatedBackend::setup() {
+    FILE* file = fopen(script_path_.c_str(), "r");
+    if (!file) {
+        fprintf(stderr, "Failed to open button script: %s\n", script_path_.c_str());
+        return false;
+    }
+
+    script_.clear();
+    next_ = 0;
+
+    char line[128];
+    int line_no = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), file)) {
+        line_no++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        long time_ms;
+        char action[16];
+        int pin;
+        int fields = sscanf(line, "%ld %15s %d", &time_ms, action, &pin);
+        if (fields <= 0) continue; // Blank or comment-only line
+
+        GPIOEdge edge;
+        edge.time_ms = time_ms;
+        if (fields >= 2 && strcmp(action, "press") == 0) {
+            edge.value = 0;
+        } else if (fields >= 2 && strcmp(action, "release") == 0) {
+            edge.value = 1;
+        } else {
+            fprintf(stderr, "%s:%d: expected \"<time_ms> press|release [pin]\"\n", script_path_.c_str(), line_no);
+            ok = false;
+            break;
+        }
+        if (!script_.empty() && time_ms < script_.back().time_ms) {
+            fprintf(stderr, "%s:%d: timestamps must not decrease\n", script_path_.c_str(), line_no);
+            ok = false;
+            break;
+        }
+        if (fields == 3 && pin_ >= 0 && pin != pin_) continue; // Edge of another pin
+        script_.push_back(edge);
+    }
+    fclose(file);
+
+    base_ms_ = realtime_ ? monotonicMs() : 0;
+    return ok;
+}
+
+long SimulatedBackend::now() const {
+    if (!realtime_) return virtual_ms_;
+
+    return monotonicMs() - base_ms_;
+}
+
+int SimulatedBackend::read() {
+    // Level after the last edge that has already happened (released before the first)
+    long t = now();
+    int value = 1;
+    for (size_t i = next_ > 0 ? next_ - 1 : 0; i < script_.size() && script_[i].time_ms <= t; i++) {
+        value = script_[i].value;
+    }
+    return value;
+}
+
+bool SimulatedBackend::readEdge(GPIOEdge& edge) {
+    if (next_ >= script_.size() || script_[next_].time_ms > now()) return false;
+
+    edge = script_[next_++];
+    edge.time_ms += base_ms_; // Report on the caller's clock
+    return true;
+}
+
+void SimulatedBackend::advanceTo(long now_ms) {
+    virtual_ms_ = now_ms;
+}
+
+long SimulatedBackend::nextEdgeTime() const {
+    return next_ < script_.size() ? script_[next_].time_ms : -1;
+}
+
+long SimulatedBackend::endTime() const {
+    return script_.empty() ? 0 : script_.back().time_ms;
+}
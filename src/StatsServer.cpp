@@ -0,0 +1,102 @@
+#include "StatsServer.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+StatsServer::StatsServer(const FrameStats& stats, const std::string& path)
+    : stats_(stats), path_(path), listen_fd_(-1), wake_fd_(-1), stopping_(false) {}
+
+StatsServer::~StatsServer() {
+    stop();
+}
+
+bool StatsServer::start() {
+    if (listen_fd_ >= 0) return true;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path_.size() >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Stats socket path too long: %s\n", path_.c_str());
+        return false;
+    }
+    strncpy(addr.sun_path, path_.c_str(), sizeof(addr.sun_path) - 1);
+
+    // Create the directory (one level, e.g. /run/led-clock) and replace a stale socket
+    size_t slash = path_.rfind('/');
+    if (slash != std::string::npos && slash > 0) {
+        std::string dir = path_.substr(0, slash);
+        if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) {
+            fprintf(stderr, "Failed to create %s: %s\n", dir.c_str(), strerror(errno));
+            return false;
+        }
+    }
+    unlink(path_.c_str());
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (listen_fd_ < 0 || wake_fd_ < 0 ||
+        bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listen_fd_, 4) < 0) {
+        fprintf(stderr, "Failed to listen on %s: %s\n", path_.c_str(), strerror(errno));
+        if (listen_fd_ >= 0) close(listen_fd_);
+        if (wake_fd_ >= 0) close(wake_fd_);
+        listen_fd_ = wake_fd_ = -1;
+        return false;
+    }
+
+    stopping_ = false;
+    thread_ = std::thread(&StatsServer::threadLoop, this);
+    return true;
+}
+
+void StatsServer::stop() {
+    if (listen_fd_ < 0) return;
+
+    stopping_ = true;
+    uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) perror("eventfd write");
+    thread_.join();
+    close(listen_fd_);
+    close(wake_fd_);
+    listen_fd_ = wake_fd_ = -1;
+    unlink(path_.c_str());
+}
+
+void StatsServer::threadLoop() {
+    while (!stopping_) {
+        struct pollfd fds[2];
+        fds[0].fd = listen_fd_;
+        fds[0].events = POLLIN;
+        fds[1].fd = wake_fd_;
+        fds[1].events = POLLIN;
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("poll");
+            break;
+        }
+        if (fds[1].revents) break;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        int client = accept4(listen_fd_, NULL, NULL, SOCK_CLOEXEC);
+        if (client < 0) continue;
+
+        // Format first, then send without blocking (the table fits the
+        // socket buffer) and without SIGPIPE if the client already left
+        char table[STATS_TABLE_SIZE];
+        FILE* out = fmemopen(table, sizeof(table), "w");
+        if (out) {
+            stats_.report(out);
+            long size = ftell(out);
+            fclose(out);
+            if (size > 0 && send(client, table, size, MSG_NOSIGNAL | MSG_DONTWAIT) < 0) perror("stats send");
+        }
+        close(client);
+    }
+}
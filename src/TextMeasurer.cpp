@@ -0,0 +1,74 @@
+#include "TextMeasurer.h"
+#include "Utf8.h"
+#include <cstring>
+
+TextMeasurer::TextMeasurer() {}
+
+TextMeasurer::~TextMeasurer() {
+    clear();
+}
+
+int TextMeasurer::width(const BitmapFont& font, const char* utf8_text) {
+    return measure(cacheFor(font), utf8_text, utf8_text + strlen(utf8_text));
+}
+
+int TextMeasurer::width(const BitmapFont& font, const char* utf8_text, size_t length) {
+    return measure(cacheFor(font), utf8_text, utf8_text + length);
+}
+
+int TextMeasurer::advance(const BitmapFont& font, uint32_t codepoint) {
+    return advance(cacheFor(font), codepoint);
+}
+
+void TextMeasurer::clear() {
+    for (size_t i = 0; i < fonts_.size(); i++) {
+        delete fonts_[i];
+    }
+    fonts_.clear();
+}
+
+TextMeasurer::FontCache& TextMeasurer::cacheFor(const BitmapFont& font) {
+    for (size_t i = 0; i < fonts_.size(); i++) {
+        if (fonts_[i]->font == &font) return *fonts_[i];
+    }
+
+    FontCache* cache = new FontCache();
+    cache->font = &font;
+    for (int i = 0; i < 128; i++) cache->ascii[i] = -1;
+    fonts_.push_back(cache);
+    return *cache;
+}
+
+int TextMeasurer::advance(FontCache& cache, uint32_t codepoint) {
+    if (codepoint < 128 && cache.ascii[codepoint] >= 0) return cache.ascii[codepoint];
+    if (codepoint >= 128) {
+        std::map<uint32_t, int>::const_iterator it = cache.other.find(codepoint);
+        if (it != cache.other.end()) return it->second;
+    }
+
+    int w = cache.font->characterWidth(codepoint);
+    if (w < 0) w = cache.font->characterWidth(REPLACEMENT_CODEPOINT);
+    if (w < 0) w = 0;
+
+    if (codepoint < 128) {
+        cache.ascii[codepoint] = w;
+    } else {
+        cache.other[codepoint] = w;
+    }
+    return w;
+}
+
+int TextMeasurer::measure(FontCache& cache, const char* text, const char* end) {
+    int w = 0;
+    while (text < end && *text) {
+        // ASCII with a cached advance: one table load, no decoding
+        uint8_t c = static_cast<uint8_t>(*text);
+        if (c < 128 && cache.ascii[c] >= 0) {
+            w += cache.ascii[c];
+            text++;
+            continue;
+        }
+        w += advance(cache, utf8NextCodepoint(text, end));
+    }
+    return w;
+}
@@ -0,0 +1,219 @@
+#include "TimeFormat.h"
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+
+TimeFormat::TimeFormat(const std::string& format, bool uppercase) : uppercase_(uppercase) {
+    text_[0] = '\0';
+    compile(format);
+}
+
+bool TimeFormat::update(const struct tm& tm) {
+    bool changed = false;
+    for (size_t i = 0; i < tokens_.size(); i++) {
+        Token& token = tokens_[i];
+        if (token.kind == LITERAL) continue;
+
+        int64_t key = periodKey(token.period, tm);
+        if (key == token.key) continue;
+
+        // Boundary crossed: re-render, but only a different text counts as a change
+        char previous[TIME_TOKEN_MAX];
+        memcpy(previous, token.text, token.length + 1);
+        render(token, tm);
+        token.key = key;
+        if (strcmp(previous, token.text) != 0) changed = true;
+    }
+    if (!changed && text_[0] != '\0') return false;
+
+    // Rebuild the output from the token texts
+    size_t length = 0;
+    for (size_t i = 0; i < tokens_.size(); i++) {
+        size_t n = tokens_[i].length;
+        if (length + n >= TIME_FORMAT_MAX) n = TIME_FORMAT_MAX - 1 - length;
+        memcpy(text_ + length, tokens_[i].text, n);
+        length += n;
+    }
+    text_[length] = '\0';
+    if (uppercase_) {
+        for (size_t i = 0; i < length; i++) {
+            text_[i] = toupper(static_cast<unsigned char>(text_[i]));
+        }
+    }
+    return true;
+}
+
+const char* TimeFormat::text() const {
+    return text_;
+}
+
+int TimeFormat::period() const {
+    static const int SECONDS[] = { 1, 60, 3600, 86400 };
+    int shortest = 0;
+    for (size_t i = 0; i < tokens_.size(); i++) {
+        if (tokens_[i].period == PERIOD_NEVER) continue;
+        int seconds = SECONDS[tokens_[i].period];
+        if (shortest == 0 || seconds < shortest) shortest = seconds;
+    }
+    return shortest;
+}
+
+void TimeFormat::compile(const std::string& format) {
+    size_t literal_start = 0;
+    for (size_t i = 0; i < format.size(); i++) {
+        if (format[i] != '%') continue;
+
+        addLiteral(format.data() + literal_start, i - literal_start);
+        size_t start = i++;
+
+        // glibc flags, field width and the E/O modifiers
+        char flag = 0;
+        while (i < format.size() && strchr("_-0^#", format[i])) flag = format[i++];
+        bool width = false;
+        while (i < format.size() && isdigit(static_cast<unsigned char>(format[i]))) {
+            width = true;
+            i++;
+        }
+        bool modifier = false;
+        if (i < format.size() && (format[i] == 'E' || format[i] == 'O')) {
+            modifier = true;
+            i++;
+        }
+        if (i >= format.size()) {
+            literal_start = start; // Trailing '%': keep it as text
+            break;
+        }
+        literal_start = i + 1;
+
+        char c = format[i];
+        std::string spec = format.substr(start, i + 1 - start);
+        bool plain = !width && !modifier && (flag == 0 || flag == '-' || flag == '_' || flag == '0');
+        if (plain && strchr("HIklMSdemyYjuw", c)) {
+            addNumber(c, flag);
+        } else if (plain && flag == 0 && c == 'T') {
+            addNumber('H', 0); addLiteral(":", 1); addNumber('M', 0); addLiteral(":", 1); addNumber('S', 0);
+        } else if (plain && flag == 0 && c == 'R') {
+            addNumber('H', 0); addLiteral(":", 1); addNumber('M', 0);
+        } else if (plain && flag == 0 && c == 'D') {
+            addNumber('m', 0); addLiteral("/", 1); addNumber('d', 0); addLiteral("/", 1); addNumber('y', 0);
+        } else if (plain && flag == 0 && c == 'F') {
+            addNumber('Y', 0); addLiteral("-", 1); addNumber('m', 0); addLiteral("-", 1); addNumber('d', 0);
+        } else if (c == '%') {
+            addLiteral("%", 1);
+        } else if (c == 'n') {
+            addLiteral("\n", 1);
+        } else if (c == 't') {
+            addLiteral("\t", 1);
+        } else if (strchr("STscXr+", c)) {
+            addStrftime(spec, PERIOD_SECOND);
+        } else if (strchr("MR", c)) {
+            addStrftime(spec, PERIOD_MINUTE);
+        } else if (strchr("HIklpPZz", c)) {
+            addStrftime(spec, PERIOD_HOUR);
+        } else {
+            addStrftime(spec, PERIOD_DAY); // Date fields and names
+        }
+    }
+    if (literal_start < format.size()) {
+        addLiteral(format.data() + literal_start, format.size() - literal_start);
+    }
+}
+
+void TimeFormat::addLiteral(const char* text, size_t length) {
+    while (length > 0) {
+        Token token = Token();
+        token.kind = LITERAL;
+        token.period = PERIOD_NEVER;
+        token.length = length < TIME_TOKEN_MAX - 1 ? length : TIME_TOKEN_MAX - 1;
+        memcpy(token.text, text, token.length);
+        token.text[token.length] = '\0';
+        tokens_.push_back(token);
+        text += token.length;
+        length -= token.length;
+    }
+}
+
+void TimeFormat::addNumber(char conversion, char pad) {
+    Token token = Token();
+    token.kind = NUMBER;
+    token.conversion = conversion;
+    token.key = -1;
+
+    // Default padding of each conversion, overridden by the flag
+    token.pad = strchr("kle", conversion) ? ' ' : (strchr("Yuw", conversion) ? 0 : '0');
+    if (pad == '-') token.pad = 0;
+    if (pad == '_') token.pad = ' ';
+    if (pad == '0') token.pad = '0';
+
+    if (conversion == 'S') {
+        token.period = PERIOD_SECOND;
+    } else if (conversion == 'M') {
+        token.period = PERIOD_MINUTE;
+    } else if (strchr("HIkl", conversion)) {
+        token.period = PERIOD_HOUR;
+    } else {
+        token.period = PERIOD_DAY;
+    }
+    tokens_.push_back(token);
+}
+
+void TimeFormat::addStrftime(const std::string& spec, Period period) {
+    Token token = Token();
+    token.kind = STRFTIME;
+    token.period = period;
+    token.key = -1;
+    strncpy(token.spec, spec.c_str(), sizeof(token.spec) - 1);
+    tokens_.push_back(token);
+}
+
+void TimeFormat::render(Token& token, const struct tm& tm) const {
+    if (token.kind == STRFTIME) {
+        token.length = strftime(token.text, sizeof(token.text), token.spec, &tm);
+        token.text[token.length] = '\0';
+        return;
+    }
+
+    int value = 0;
+    int digits = 2;
+    int hour12 = tm.tm_hour % 12 == 0 ? 12 : tm.tm_hour % 12;
+    switch (token.conversion) {
+        case 'H': value = tm.tm_hour; break;
+        case 'k': value = tm.tm_hour; break;
+        case 'I': value = hour12; break;
+        case 'l': value = hour12; break;
+        case 'M': value = tm.tm_min; break;
+        case 'S': value = tm.tm_sec; break;
+        case 'd': value = tm.tm_mday; break;
+        case 'e': value = tm.tm_mday; break;
+        case 'm': value = tm.tm_mon + 1; break;
+        case 'y': value = (tm.tm_year + 1900) % 100; break;
+        case 'Y': value = tm.tm_year + 1900; digits = 1; break;
+        case 'j': value = tm.tm_yday + 1; digits = 3; break;
+        case 'u': value = tm.tm_wday == 0 ? 7 : tm.tm_wday; digits = 1; break;
+        case 'w': value = tm.tm_wday; digits = 1; break;
+    }
+
+    // Render right to left into a small scratch buffer
+    char scratch[12];
+    int n = 0;
+    do {
+        scratch[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0 && n < 11);
+    while (token.pad && n < digits) scratch[n++] = token.pad;
+
+    token.length = n;
+    for (int i = 0; i < n; i++) token.text[i] = scratch[n - 1 - i];
+    token.text[n] = '\0';
+}
+
+int64_t TimeFormat::periodKey(Period period, const struct tm& tm) {
+    // Day key includes the UTC offset so zone fields follow DST changes
+    int64_t key = (static_cast<int64_t>(tm.tm_year) * 400 + tm.tm_yday) * 2 + (tm.tm_isdst > 0 ? 1 : 0);
+    if (period == PERIOD_DAY) return key;
+    key = key * 24 + tm.tm_hour;
+    if (period == PERIOD_HOUR) return key;
+    key = key * 60 + tm.tm_min;
+    if (period == PERIOD_MINUTE) return key;
+    return key * 61 + tm.tm_sec; // tm_sec can be 60 (leap second)
+}
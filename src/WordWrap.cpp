@@ -0,0 +1,126 @@
+#include "WordWrap.h"
+#include "Utf8.h"
+#include <cstring>
+#include <climits>
+
+WordWrap::WordWrap() : words_(0), space_width_(0), line_count_(0) {}
+
+int WordWrap::wrap(TextMeasurer& measurer, const BitmapFont& font, const char* text, int max_width, Mode mode) {
+    space_width_ = measurer.advance(font, ' ');
+    words_ = 0;
+    line_count_ = 0;
+
+    // Split on spaces, accumulating each word's width as it is scanned
+    const char* end = text + strlen(text);
+    const char* p = text;
+    while (p < end) {
+        while (p < end && *p == ' ') p++;
+        if (p == end) break;
+
+        // Past the word limit the remainder becomes one last "word"
+        bool last = words_ == WRAP_MAX_WORDS - 1;
+        word_offset_[words_] = p - text;
+        int width = 0;
+        const char* word_end = p;
+        while (p < end && (last || *p != ' ')) {
+            width += measurer.advance(font, utf8NextCodepoint(p, end));
+            if (*(p - 1) != ' ') word_end = p;
+        }
+        if (last) width -= (p - word_end) * space_width_; // Trailing spaces
+        word_end_[words_] = word_end - text;
+        word_width_[words_] = width;
+        words_++;
+    }
+    if (words_ == 0) return 0;
+
+    breakGreedy(max_width);
+    if (mode == BALANCED) breakBalanced(max_width);
+    return line_count_;
+}
+
+int WordWrap::lineCount() const {
+    return line_count_;
+}
+
+const WrapLine& WordWrap::line(int i) const {
+    return lines_[i];
+}
+
+WordWrap::Mode WordWrap::parseMode(const char* name) {
+    return strcmp(name, "balanced") == 0 ? BALANCED : GREEDY;
+}
+
+int WordWrap::span(int first, int last) const {
+    int width = (last - first) * space_width_;
+    for (int i = first; i <= last; i++) width += word_width_[i];
+    return width;
+}
+
+void WordWrap::breakGreedy(int max_width) {
+    int ends[WRAP_MAX_LINES];
+    int count = 0;
+    int line_start = 0;
+    int width = 0;
+    for (int i = 0; i < words_; i++) {
+        int with_word = i == line_start ? word_width_[i] : width + space_width_ + word_width_[i];
+
+        // Start a new line with this word (the last line takes the rest)
+        if (i > line_start && with_word > max_width && count < WRAP_MAX_LINES - 1) {
+            ends[count++] = i - 1;
+            line_start = i;
+            with_word = word_width_[i];
+        }
+        width = with_word;
+    }
+    ends[count++] = words_ - 1;
+    setLines(ends, count);
+}
+
+void WordWrap::breakBalanced(int max_width) {
+    // cost[k][i]: best cost of words [0, i] on k + 1 lines; from[k][i]: last word of line k
+    long cost[WRAP_MAX_LINES][WRAP_MAX_WORDS];
+    int from[WRAP_MAX_LINES][WRAP_MAX_WORDS];
+    int lines = line_count_;
+    if (lines < 2) return;
+
+    for (int k = 0; k < lines; k++) {
+        for (int i = 0; i < words_; i++) {
+            cost[k][i] = LONG_MAX;
+            from[k][i] = 0;
+            int j_max = k == 0 ? 0 : i;
+            for (int j = k; j <= j_max; j++) {
+                // Line k holds words [j, i]; the previous lines hold [0, j - 1]
+                if (k > 0 && cost[k - 1][j - 1] == LONG_MAX) continue;
+
+                int width = span(j, i);
+                if (width > max_width && i != j) continue; // Overflow allowed for a single word only
+                long slack = width > max_width ? 0 : max_width - width;
+                long total = slack * slack + (k > 0 ? cost[k - 1][j - 1] : 0);
+                if (total < cost[k][i]) {
+                    cost[k][i] = total;
+                    from[k][i] = j;
+                }
+            }
+        }
+    }
+    if (cost[lines - 1][words_ - 1] == LONG_MAX) return; // Keep the greedy lines
+
+    int ends[WRAP_MAX_LINES];
+    int last = words_ - 1;
+    for (int k = lines - 1; k >= 0; k--) {
+        ends[k] = last;
+        last = from[k][last] - 1;
+    }
+    setLines(ends, lines);
+}
+
+void WordWrap::setLines(const int* ends, int count) {
+    int first = 0;
+    for (int k = 0; k < count; k++) {
+        lines_[k].offset = word_offset_[first];
+        lines_[k].length = word_end_[ends[k]] - word_offset_[first];
+        lines_[k].width = span(first, ends[k]);
+        first = ends[k] + 1;
+    }
+    line_count_ = count;
+}
@@ -1,11 +1,27 @@
 // LED Matrix Clock in C++ with Config, Color Selection, and Brightness Control
 // Based on hzeller/rpi-rgb-led-matrix examples
 
-#include "led-matrix.h"
-#include "graphics.h"
 #include "version.h"
 #include "Config.h"
-#include "GPIOButton.h"
+#include "ConfigSaver.h"
+#include "InputManager.h"
+#include "RotaryEncoder.h"
+#include "LatencyTracker.h"
+#include "MonotonicClock.h"
+#include "FrameScheduler.h"
+#include "FrameKey.h"
+#include "TextMeasurer.h"
+#include "LayoutEngine.h"
+#include "BitmapFont.h"
+#include "Display.h"
+#include "FrameBuffer.h"
+#include "FrameRecorder.h"
+#include "FrameStats.h"
+#include "StatsServer.h"
+#include "Renderer.h"
+#include "RenderSweep.h"
+#include "TimeFormat.h"
+#include "LocalTime.h"
 #include "Animator.h"
 #include "BorderSnakeAnimation.h"
 
@@ -21,6 +37,7 @@
 #include <csignal>
 #include <cstring>
 #include <string>
+#include <algorithm>
 #include <cmath>
 #include <locale.h>
 #include <sys/socket.h>
@@ -28,30 +45,34 @@
 #include <arpa/inet.h>
 #include <ifaddrs.h>
 #include <vector>
-#include <sstream>
-
-using namespace rgb_matrix;
 
 volatile bool interrupt_received = false;
 static void InterruptHandler(int) {
     interrupt_received = true;
 }
 
+// SIGUSR1: print the input latency and frame stage histograms (kill -USR1 $(pidof clock-full))
+volatile sig_atomic_t latency_report_requested = 0;
+static void LatencyReportHandler(int) {
+    latency_report_requested = 1;
+}
+
 // Global state for button callbacks
 Config* g_config = nullptr;
-RGBMatrix* g_matrix = nullptr;
 long* g_message_display_until = nullptr;
 std::string* g_message_text = nullptr;
-Color* g_message_color = nullptr;
+RGBColor* g_message_color = nullptr;
 Animator* g_animator = nullptr;
 BorderSnakeAnimation* g_snakeAnimation = nullptr;
 bool g_showing_auto_transition = false;
-
-// Get current time in milliseconds
-long getCurrentTimeMs() {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+long g_config_save_at = 0;            // Pending config save, written after the next publish (0 = none)
+
+// Print how many frames were drawn and how many were skipped as unchanged
+void printFrameStats(unsigned long drawn, unsigned long elided) {
+    unsigned long total = drawn + elided;
+    printf("🖼  Frames: %lu drawn, %lu elided (%.1f%% skipped)\n",
+           drawn, elided, total > 0 ? 100.0 * elided / total : 0.0);
+    fflush(stdout);
 }
 
 // Get local IP address
@@ -89,8 +110,7 @@ void onShortPress() {
     g_config->brightness += BRIGHTNESS_INC_STEP;
     if (g_config->brightness > MAX_BRIGHTNESS) g_config->brightness = MIN_BRIGHTNESS;
 
-    g_matrix->SetBrightness(g_config->brightness);
-    g_config->save(CONFIG_PATH);
+    g_config_save_at = monotonicMs();
 
     // Show brightness message
     char brightness_msg[16];
@@ -99,11 +119,11 @@ void onShortPress() {
 
     // Color warning for brightness > 100%
     if (g_config->brightness > 100) {
-        *g_message_color = Color(255, 100, 0); // Orange warning for high brightness
+        *g_message_color = RGBColor(255, 100, 0); // Orange warning for high brightness
     } else {
-        *g_message_color = Color(255, 255, 255); // White for normal brightness
+        *g_message_color = RGBColor(255, 255, 255); // White for normal brightness
     }
-    *g_message_display_until = getCurrentTimeMs() + COLOR_DISPLAY_MS;
+    *g_message_display_until = monotonicMs() + COLOR_DISPLAY_MS;
 
     printf("💡 Brightness: %d%%\n", g_config->brightness);
 }
@@ -164,12 +184,67 @@ void onLongPress() {
     }
 
     *g_message_display_until = 0; // No text message - just show the transition
-    g_config->save(CONFIG_PATH);
+    g_config_save_at = monotonicMs();
     printf("🎨 Color: %s\n", g_message_text->c_str());
 }
 
+// Encoder callback: adjust brightness or hue continuously
+void onEncoderTurn(int detents, long current_time) {
+    char msg[16];
+    if (g_config->encoderFunction == "hue") {
+        g_config->hueShift = ((g_config->hueShift + detents * g_config->encoderStep) % 360 + 360) % 360;
+        snprintf(msg, sizeof(msg), "HUE %d", g_config->hueShift);
+        *g_message_color = RGBColor(255, 255, 255);
+        printf("🌈 Hue shift: %d°\n", g_config->hueShift);
+    } else {
+        g_config->brightness += detents * g_config->encoderStep;
+        if (g_config->brightness > MAX_BRIGHTNESS) g_config->brightness = MAX_BRIGHTNESS;
+        if (g_config->brightness < MIN_BRIGHTNESS) g_config->brightness = MIN_BRIGHTNESS;
+        snprintf(msg, sizeof(msg), "%d%%", g_config->brightness);
+        *g_message_color = RGBColor(255, 255, 255);
+        printf("💡 Brightness: %d%%\n", g_config->brightness);
+    }
+    *g_message_text = msg;
+    *g_message_display_until = current_time + COLOR_DISPLAY_MS;
+
+    // Spinning produces many small changes: save once the knob is idle
+    g_config_save_at = current_time + ENCODER_SAVE_DELAY_MS;
+}
+
+// Print command-line usage
+void printUsage(const char* program) {
+    printf("Usage: %s [--record <file>] [--render-sweep <dir> [--update-goldens]]\n", program);
+    printf("  --record <file>       Record every drawn frame with its time (.y4m = Y4M, otherwise PPM stream)\n");
+    printf("  --render-sweep <dir>  Render every font and layout at a fixed time, compare with the golden\n");
+    printf("                        frames in <dir>, print the render time and exit (missing golden = failure)\n");
+    printf("  --update-goldens      With --render-sweep: write missing and differing golden frames instead\n");
+}
+
+int main(int argc, char** argv) {
+    // Command line
+    std::string record_path;
+    std::string sweep_dir;
+    bool update_goldens = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--render-sweep") == 0 && i + 1 < argc) {
+            sweep_dir = argv[++i];
+        } else if (strcmp(argv[i], "--update-goldens") == 0) {
+            update_goldens = true;
+        } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (update_goldens && sweep_dir.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
 
-int main(int, char**) {
     // Set locale for date/time formatting (from Makefile LOCALE variable)
 #ifdef SYSTEM_LOCALE
     setlocale(LC_TIME, SYSTEM_LOCALE);
@@ -182,6 +257,12 @@ int main(int, char**) {
     printf("  LED Matrix Clock v%s\n", VERSION_STRING);
     printf("═══════════════════════════════════════\n\n");
 
+    // Golden-frame render sweep: no display, config or input needed
+    if (!sweep_dir.empty()) {
+        RenderSweep sweep(FONT_DIR, sweep_dir, 64, 32, update_goldens);
+        return sweep.run() == 0 ? 0 : 1;
+    }
+
     // Load config using Config class
     Config config;
     bool config_loaded = config.load(CONFIG_PATH);
@@ -227,104 +308,195 @@ int main(int, char**) {
     }
     printf("\n");
 
-    // Load fonts
+    // Load fonts (decoded into glyph spans for the framebuffer blitter)
     // Date and time fonts from config with fallback to defaults
-    std::string date_font_path = "/root/fonts/" + config.dateFont;
-    std::string time_font_path = "/root/fonts/" + config.timeFont;
+    std::string date_font_path = FONT_DIR + config.dateFont;
+    std::string time_font_path = FONT_DIR + config.timeFont;
 
-    rgb_matrix::Font font_date;
-    if (!font_date.LoadFont(date_font_path.c_str())) {
+    BitmapFont font_date;
+    if (!font_date.load(date_font_path.c_str())) {
         fprintf(stderr, "⚠ Couldn't load date font: %s, using default 5x8.bdf\n", date_font_path.c_str());
-        if (!font_date.LoadFont("/root/fonts/5x8.bdf")) {
+        if (!font_date.load(FONT_DIR "5x8.bdf")) {
             fprintf(stderr, "❌ Failed to load default date font\n");
             return 1;
         }
     }
 
-    rgb_matrix::Font font_time;
-    if (!font_time.LoadFont(time_font_path.c_str())) {
+    BitmapFont font_time;
+    if (!font_time.load(time_font_path.c_str())) {
         fprintf(stderr, "⚠ Couldn't load time font: %s, using default 7x14B.bdf\n", time_font_path.c_str());
-        if (!font_time.LoadFont("/root/fonts/7x14B.bdf")) {
+        if (!font_time.load(FONT_DIR "7x14B.bdf")) {
             fprintf(stderr, "❌ Failed to load default time font\n");
             return 1;
         }
     }
 
     // Tiny font for IP display (always 4x6.bdf)
-    rgb_matrix::Font font_tiny;
-    const char *font_tiny_path = "/root/fonts/4x6.bdf";
-    if (!font_tiny.LoadFont(font_tiny_path)) {
+    BitmapFont font_tiny;
+    const char *font_tiny_path = FONT_DIR "4x6.bdf";
+    if (!font_tiny.load(font_tiny_path)) {
         fprintf(stderr, "Couldn't load tiny font: %s\n", font_tiny_path);
         return 1;
     }
 
     // For message display, use larger of the two fonts
-    rgb_matrix::Font* font_message = font_time.height() >= font_date.height() ? &font_time : &font_date;
-
-    // Matrix configuration
-    RGBMatrix::Options matrix_options;
-    RuntimeOptions runtime_opt;
-
-    matrix_options.rows = 32;
-    matrix_options.cols = 64;
-    matrix_options.chain_length = 1;
-    matrix_options.parallel = 1;
-    matrix_options.hardware_mapping = "adafruit-hat";
-    matrix_options.led_rgb_sequence = "RBG";
-    runtime_opt.gpio_slowdown = 4;
-    runtime_opt.drop_privileges = 0; // Don't drop privileges - we need root for config file writes
-    matrix_options.brightness = config.brightness;
-
-    // Create matrix
-    RGBMatrix *matrix = RGBMatrix::CreateFromOptions(matrix_options, runtime_opt);
-    if (matrix == NULL) {
-        fprintf(stderr, "Failed to create matrix\n");
+    BitmapFont* font_message = font_time.height() >= font_date.height() ? &font_time : &font_date;
+
+    // Frame scheduler: block the signals before the display and input
+    // threads start so they are only delivered through its signalfd
+    FrameScheduler scheduler;
+    sigset_t watched_signals;
+    sigemptyset(&watched_signals);
+    sigaddset(&watched_signals, SIGTERM);
+    sigaddset(&watched_signals, SIGINT);
+    sigaddset(&watched_signals, SIGUSR1);
+    bool event_driven = scheduler.setup(watched_signals);
+
+    // Setup GPIO buttons (all lines read in one batched request). Pin modes
+    // and pull-ups are read-modify-writes of registers shared with the LED
+    // matrix pins, so they are set before the matrix starts refreshing.
+    GestureTiming gesture_timing;
+    gesture_timing.debounce_ms = config.gestureDebounceMs;
+    gesture_timing.long_press_ms = config.gestureLongPressMs;
+    gesture_timing.multi_tap_ms = config.gestureMultiTapMs;
+    gesture_timing.repeat_interval_ms = config.gestureRepeatIntervalMs;
+    InputManager input(config.buttonBackend, config.buttons, gesture_timing);
+    if (!input.setup()) {
+        fprintf(stderr, "Failed to setup GPIO buttons\n");
         return 1;
     }
+    for (size_t i = 0; i < config.buttons.size(); i++) {
+        printf("✓ GPIO %d (%s) configured with pull-up (%s backend)\n",
+               config.buttons[i].pin, config.buttons[i].name.c_str(), input.backendName());
+    }
 
-    printf("✓ Matrix initialized\n");
+    // Setup rotary encoder pins (same constraint)
+    RotaryEncoder encoder(config.buttonBackend, config.encoderPinA, config.encoderPinB, config.encoderStepsPerDetent);
+    bool encoder_active = false;          // Set up this run (a failure is not saved to the config)
+    if (config.encoderEnabled) {
+        if (encoder.setup()) {
+            encoder_active = true;
+        } else {
+            fprintf(stderr, "⚠ Failed to setup rotary encoder on GPIO %d/%d\n", config.encoderPinA, config.encoderPinB);
+        }
+    }
+
+    // Display: the LED matrix, or an in-memory canvas (make headless)
+    Display* display = createDisplay(64, 32, config.brightness);
+    if (!display->setup()) {
+        fprintf(stderr, "Failed to create display\n");
+        delete display;
+        return 1;
+    }
 
-    // Setup signal handler
-    signal(SIGTERM, InterruptHandler);
-    signal(SIGINT, InterruptHandler);
+    printf("✓ Display initialized (%s)\n", display->name());
 
-    // Create canvases (for double buffering and text measurement)
-    FrameCanvas *offscreen_canvas = matrix->CreateFrameCanvas();
-    FrameCanvas *temp_canvas = matrix->CreateFrameCanvas();
+    // Frame recording: frames are copied into a queue and encoded on a
+    // background thread, so recording does not change frame timing
+    FrameRecorder recorder(64, 32);
+    if (!record_path.empty()) {
+        if (!recorder.open(record_path)) {
+            delete display;
+            return 1;
+        }
+        printf("✓ Recording frames to %s\n", record_path.c_str());
+    }
+
+    // Setup signal handlers (only when the scheduler has no signalfd)
+    if (!event_driven) {
+        fprintf(stderr, "⚠ Event-driven scheduler unavailable, redrawing every %d ms\n", FRAME_INTERVAL_MS);
+        signal(SIGTERM, InterruptHandler);
+        signal(SIGINT, InterruptHandler);
+        signal(SIGUSR1, LatencyReportHandler);
+    }
+
+    // Frames are composed in software and only the changed area is
+    // transferred to the display's offscreen canvas
+    FrameBuffer framebuffer(64, 32);
+
+    // Text widths from cached glyph advances (no pixels drawn to measure)
+    TextMeasurer measurer;
+
+    // Date/time positions, recomputed only when their inputs change
+    LayoutEngine layout_engine(config, font_date, font_time, measurer, 64, 32);
+
+    long message_shown_at = -1;           // When the current message appeared (-1 = none)
 
     // Get local IP address
     std::string local_ip = getLocalIP();
     printf("🌐 Local IP: %s\n", local_ip.c_str());
 
     // Display IP and version at startup
-    long startup_time = getCurrentTimeMs();
+    long startup_time = monotonicMs();
     long message_display_until = startup_time + VERSION_DISPLAY_MS;
-    Color startup_color(255, 255, 255);
+    RGBColor startup_color(255, 255, 255);
 
     // Show IP and version for a few seconds
-    offscreen_canvas->Clear();
+    framebuffer.clear();
 
     // Draw IP address in tiny font (centered)
-    int ip_width = DrawText(temp_canvas, font_tiny, 0, 0, startup_color, NULL, local_ip.c_str());
+    int ip_width = measurer.width(font_tiny, local_ip.c_str());
     int ip_x = (64 - ip_width) / 2;
     int ip_y = 12; // Upper half
-    DrawText(offscreen_canvas, font_tiny, ip_x, ip_y, startup_color, NULL, local_ip.c_str());
+    framebuffer.drawText(font_tiny, ip_x, ip_y, startup_color, local_ip.c_str());
 
     // Draw version in date font below (centered)
     std::string version_text = std::string(Locale::MSG_VERSION_PREFIX) + std::string(VERSION_STRING);
-    int version_width = DrawText(temp_canvas, font_date, 0, 0, startup_color, NULL, version_text.c_str());
+    int version_width = measurer.width(font_date, version_text.c_str());
     int version_x = (64 - version_width) / 2;
     int version_y = 26; // Lower half
-    DrawText(offscreen_canvas, font_date, version_x, version_y, startup_color, NULL, version_text.c_str());
+    framebuffer.drawText(font_date, version_x, version_y, startup_color, version_text.c_str());
 
-    offscreen_canvas = matrix->SwapOnVSync(offscreen_canvas);
+    recorder.record(framebuffer.pixels(), monotonicUs());
+    framebuffer.transfer(display->offscreen());
+    display->swap();
 
     // Wait for display duration
     usleep(VERSION_DISPLAY_MS * 1000);
 
+    // Frames are drawn on a render thread from published frame descriptions
+    // (scene, overlays, transfer, SwapOnVSync, brightness); this thread only
+    // runs the clock logic
+    Renderer renderer(display, framebuffer, layout_engine, *font_message);
+    if (recorder.recording()) renderer.setRecorder(&recorder);
+
+    // Per-stage frame timings of both threads, served on a local socket
+    FrameStats frame_stats;
+    renderer.setStats(&frame_stats);
+    StatsServer stats_server(frame_stats, STATS_SOCKET_PATH);
+    if (stats_server.start()) {
+        printf("✓ Frame statistics on %s\n", STATS_SOCKET_PATH);
+    } else {
+        fprintf(stderr, "⚠ Frame statistics socket unavailable\n");
+    }
+
+    // Config changes are saved from snapshots on a writer thread, so a slow
+    // SD card never holds up the frames that show them
+    ConfigSaver config_saver(CONFIG_PATH);
+    if (!config_saver.start()) {
+        fprintf(stderr, "⚠ Config writer thread unavailable, saving on the logic thread\n");
+    }
+
+    // Stop the threads using the display, then clear and release it
+    // (normal exit and failed startup alike)
+    auto shutdown = [&]() {
+        renderer.stop();
+        stats_server.stop();
+        config_saver.stop();
+        recorder.close();
+        display->clear();
+        delete display;
+    };
+
+    if (!renderer.start()) {
+        fprintf(stderr, "Failed to start render thread\n");
+        shutdown();
+        return 1;
+    }
+
     // Reset message state for normal operation
     std::string message_text = "";
-    Color message_color(255, 255, 255);
+    RGBColor message_color(255, 255, 255);
 
     // Create Animator instance
     Animator animator;
@@ -334,64 +506,127 @@ int main(int, char**) {
 
     // Setup global pointers for button callbacks
     g_config = &config;
-    g_matrix = matrix;
     g_message_display_until = &message_display_until;
     g_message_text = &message_text;
     g_message_color = &message_color;
     g_animator = &animator;
     g_snakeAnimation = &snakeAnimation;
 
-    // Setup GPIO button using GPIOButton class
-    GPIOButton button(GPIO_NUM);
-    if (!button.setup()) {
-        fprintf(stderr, "Failed to setup GPIO %d\n", GPIO_NUM);
-        return 1;
+    GPIOButton* button = input.button("main");
+    if (button) {
+        button->onShortPress(onShortPress);
+        button->onLongPress(onLongPress);
+    } else {
+        fprintf(stderr, "⚠ No \"main\" button configured, brightness/color control disabled\n");
+    }
+
+    // Edge-to-photon latency of button gestures (reported on SIGUSR1): the
+    // oldest input not yet taken by the render thread rides along with every
+    // published frame. Several inputs before it is taken share its photons.
+    long input_edge_ms = 0;               // Edge time of the pending input
+    int64_t input_dispatch_us = 0;        // Its dispatch time (0 = none pending)
+    bool input_published = false;         // A published frame carries it
+    input.onDispatch([&](const ButtonEvent& event) {
+        if (input_dispatch_us != 0) return;
+        input_edge_ms = event.time_ms;
+        input_dispatch_us = monotonicUs();
+        input_published = false;
+    });
+
+    // Classify gestures on a dedicated input thread (edge-timestamped),
+    // the main loop then only drains the decoded events
+    input.setNotifyFd(scheduler.notifyFd());
+    bool input_threaded = input.start();
+    if (input_threaded) {
+        printf("✓ Button input thread started\n");
+    } else {
+        printf("⚠ Button input thread unavailable, polling every frame\n");
+    }
+
+    // Decode the rotary encoder on its own thread, drained every frame
+    bool encoder_threaded = false;
+    if (encoder_active) {
+        encoder.setNotifyFd(scheduler.notifyFd());
+        encoder_threaded = encoder.start();
+        printf("✓ Rotary encoder on GPIO %d/%d (%s, %s)\n", config.encoderPinA, config.encoderPinB,
+               config.encoderFunction.c_str(), encoder_threaded ? "input thread" : "polled");
     }
-    button.onShortPress(onShortPress);
-    button.onLongPress(onLongPress);
-    printf("✓ GPIO %d configured with pull-up\n", GPIO_NUM);
 
     // Color transition state
     int current_color_index = 0;
     int next_color_index = 1;
-    long transition_start_time = getCurrentTimeMs();
+    long transition_start_time = monotonicMs();
     long intervalMs = config.colorTransitionIntervalMinutes * 60 * 1000; // Convert minutes to ms
     long next_color_change_time = transition_start_time + intervalMs;
 
+    // Local time with the zone loaded once per UTC offset period
+    LocalTime local_time;
+    if (!local_time.setup()) {
+        printf("⚠ Time zone file not watched, zone changes need a restart\n");
+    }
+
+    // Date and time formats, compiled once into token programs
+    TimeFormat date_format(config.dateFormat, true);
+    TimeFormat time_format(config.timeFormat);
+
+    // Shortest wall-clock period that changes what is shown (1 s or 1 min)
+    // (hour and day fields change on minute boundaries in every time zone)
+    int wall_period = 0;
+    int periods[2] = { config.showTime ? time_format.period() : 0, config.showDate ? date_format.period() : 0 };
+    for (int i = 0; i < 2; i++) {
+        int period = periods[i] > 60 ? 60 : periods[i];
+        if (period > 0 && (wall_period == 0 || period < wall_period)) wall_period = period;
+    }
+    bool polled_input = !input_threaded || (encoder_active && !encoder_threaded);
+
+    // Redundant frame elision
+    FrameKey frame_key;
+    uint64_t last_frame_key = 0;
+    unsigned long frames_elided = 0;
+
     printf("Clock started.\n");
+    printf("  Redraw: every %s%s\n", wall_period == 1 ? "second" : "minute",
+           polled_input ? " (input polled every frame)" : "");
     printf("  Short press: Cycle brightness (%d%% - %d%%)\n", MIN_BRIGHTNESS, MAX_BRIGHTNESS);
     printf("  Long press: Cycle colors / AUTO mode\n");
 
     while (!interrupt_received) {
-        long current_time = getCurrentTimeMs();
-
-        // Poll button for press events
-        button.poll(current_time);
+        int64_t loop_start_us = monotonicUs();
+        long current_time = monotonicMs();
 
-        // Clear canvas
-        offscreen_canvas->Clear();
+        // The render thread has drawn the pending input: track the next one
+        if (input_dispatch_us != 0 && renderer.inputTaken() >= input_dispatch_us) input_dispatch_us = 0;
 
-        // Determine current color and display
-        Color display_color;
-        if (current_time < message_display_until) {
-            // Display message (color name or brightness)
-            int width = DrawText(temp_canvas, *font_message, 0, 0, message_color, NULL, message_text.c_str());
-            int x = (64 - width) / 2;
-            int y = 20;
+        // Dispatch button events (drained from the input thread, or polled)
+        input.poll(current_time);
 
-            DrawText(offscreen_canvas, *font_message, x, y, message_color, NULL, message_text.c_str());
-        } else if (g_showing_auto_transition && animator.isAnimating()) {
+        // Apply encoder rotation and save once it settles
+        if (encoder_active) {
+            int detents = encoder.poll();
+            if (detents != 0) onEncoderTurn(detents, current_time);
+        }
+        int64_t input_done_us = monotonicUs();
+        frame_stats.record(FrameStats::INPUT, input_done_us - loop_start_us);
+
+        // Message overlay: fades in when it appears and out before it expires
+        bool message_active = current_time < message_display_until;
+        if (message_active && message_shown_at < 0) message_shown_at = current_time;
+        if (!message_active) message_shown_at = -1;
+        long message_ramp = message_active ? std::min(current_time - message_shown_at, message_display_until - current_time) : 0;
+        uint8_t message_opacity = message_ramp >= MESSAGE_FADE_MS ? 255 : message_ramp * 255 / MESSAGE_FADE_MS;
+
+        // Determine what the base frame shows
+        FrameContent show;
+        RGBColor display_color;
+        const char* date_text = "";
+        const char* time_text = "";
+        if (g_showing_auto_transition && animator.isAnimating()) {
             // Show AUTO message during transition to AUTO mode
-            RGBColor rgb = animator.update();
-            display_color = Color(rgb.r, rgb.g, rgb.b);
-
-            int width = DrawText(temp_canvas, *font_message, 0, 0, display_color, NULL, Locale::MSG_AUTO);
-            int x = (64 - width) / 2;
-            int y = 20;
-
-            DrawText(offscreen_canvas, *font_message, x, y, display_color, NULL, Locale::MSG_AUTO);
+            show = SHOW_AUTO;
+            display_color = Animator::rotateHue(animator.update(), config.hueShift);
         } else {
             // Normal clock display
+            show = SHOW_CLOCK;
 
             // Reset AUTO transition flag when animation is done
             if (g_showing_auto_transition && !animator.isAnimating()) {
@@ -401,12 +636,11 @@ int main(int, char**) {
             // Check if there's an active manual transition from button press
             if (animator.isAnimating()) {
                 // Use animator's current color during manual transition
-                RGBColor rgb = animator.update();
-                display_color = Color(rgb.r, rgb.g, rgb.b);
+                display_color = animator.update();
             } else if (config.fixed_color >= 0 && config.fixed_color < (int)config.colors.size()) {
                 // Fixed color mode (no animation)
                 const NamedColor& nc = config.colors[config.fixed_color];
-                display_color = Color(nc.r, nc.g, nc.b);
+                display_color = RGBColor(nc.r, nc.g, nc.b);
             } else if (config.colorTransitionEnabled && config.colors.size() >= 2) {
                 // AUTO mode with smooth transitions
                 long time_until_next_change = next_color_change_time - current_time;
@@ -423,8 +657,7 @@ int main(int, char**) {
                             config.colorTransitionDurationMs
                         );
                     }
-                    RGBColor rgb = animator.update();
-                    display_color = Color(rgb.r, rgb.g, rgb.b);
+                    display_color = animator.update();
                 } else if (time_until_next_change <= 0) {
                     // Time to switch to next color
                     current_color_index = next_color_index;
@@ -433,7 +666,7 @@ int main(int, char**) {
 
                     // Display the new current color
                     const NamedColor& nc = config.colors[current_color_index];
-                    display_color = Color(nc.r, nc.g, nc.b);
+                    display_color = RGBColor(nc.r, nc.g, nc.b);
 
                     // Debug log
                     printf("🔄 Color changed to %s RGB(%d,%d,%d), next in %dmin\n",
@@ -441,159 +674,122 @@ int main(int, char**) {
                 } else {
                     // Not in transition - display current color
                     const NamedColor& nc = config.colors[current_color_index];
-                    display_color = Color(nc.r, nc.g, nc.b);
+                    display_color = RGBColor(nc.r, nc.g, nc.b);
                 }
             } else {
                 // Fallback - use first color or yellow
                 if (config.colors.size() > 0) {
                     const NamedColor& nc = config.colors[0];
-                    display_color = Color(nc.r, nc.g, nc.b);
+                    display_color = RGBColor(nc.r, nc.g, nc.b);
                 } else {
-                    display_color = Color(255, 220, 0);
+                    display_color = RGBColor(255, 220, 0);
                 }
             }
 
-            // Get current time
-            time_t now = time(NULL);
-            struct tm *tm_info = localtime(&now);
-
-            // Format date and time using config formats
-            char date_buffer[32];
-            char time_buffer[16];
-            strftime(date_buffer, sizeof(date_buffer), config.dateFormat.c_str(), tm_info);
-            strftime(time_buffer, sizeof(time_buffer), config.timeFormat.c_str(), tm_info);
-
-            // Convert date to uppercase
-            for (size_t i = 0; i < strlen(date_buffer); i++) {
-                date_buffer[i] = toupper(date_buffer[i]);
+            // Apply the user hue shift (encoder in hue mode)
+            if (config.hueShift != 0) {
+                display_color = Animator::rotateHue(display_color, config.hueShift);
             }
 
-            // Calculate centered positions
-            const int MATRIX_WIDTH = 64;
-            const int MATRIX_HEIGHT = 32;
-
-            // Conditional rendering based on config
-            if (config.showDate && config.showTime) {
-                // Show both date and time
-                int date_width = DrawText(temp_canvas, font_date, 0, 0, display_color, NULL, date_buffer);
-                int time_width = DrawText(temp_canvas, font_time, 0, 0, display_color, NULL, time_buffer);
-
-                // Get font metrics
-                int date_height = font_date.height();
-                int time_height = font_time.height();
-                int date_baseline = font_date.baseline();
-                int time_baseline = font_time.baseline();
-
-                // Calculate visual heights based on ignoreDescenders flags
-                // If ignoring descenders (for uppercase/numbers only), use only ascent
-                // Otherwise use full font height
-                int date_visual_height = config.dateIgnoreDescenders ? date_baseline : date_height;
-                int time_visual_height = config.timeIgnoreDescenders ? time_baseline : time_height;
-
-                // Use configured spacing, but clamp if needed to fit on display
-                int spacing = config.dateTimeSpacing;
-                int total_height = date_visual_height + spacing + time_visual_height;
-                if (total_height > MATRIX_HEIGHT) {
-                    // Clamp spacing to fit
-                    spacing = MATRIX_HEIGHT - date_visual_height - time_visual_height;
-                    if (spacing < 0) spacing = 0;  // Minimum spacing
-                    total_height = date_visual_height + spacing + time_visual_height;
-                }
-
-                // Center the visible content vertically
-                int start_y = (MATRIX_HEIGHT - total_height) / 2;
-
-                // Calculate X positions (horizontal centering)
-                int date_x = (MATRIX_WIDTH - date_width) / 2;
-                int time_x = (MATRIX_WIDTH - time_width) / 2;
-
-                // Calculate Y positions (baseline positions for DrawText)
-                int date_y = start_y + date_baseline;
-                int time_y = start_y + date_visual_height + spacing + time_baseline;
-
-                // Draw date and time
-                DrawText(offscreen_canvas, font_date, date_x, date_y, display_color, NULL, date_buffer);
-                DrawText(offscreen_canvas, font_time, time_x, time_y, display_color, NULL, time_buffer);
-            } else if (config.showDate && !config.showTime) {
-                // Show only date (centered vertically, with word wrap if needed)
-                int date_width = DrawText(temp_canvas, font_date, 0, 0, display_color, NULL, date_buffer);
-
-                if (date_width <= MATRIX_WIDTH) {
-                    // Date fits in one line - center it
-                    int date_x = (MATRIX_WIDTH - date_width) / 2;
-                    int date_y = (MATRIX_HEIGHT / 2) + (font_date.baseline() / 2);
-                    DrawText(offscreen_canvas, font_date, date_x, date_y, display_color, NULL, date_buffer);
-                } else {
-                    // Date too wide - split into words and wrap
-                    std::vector<std::string> lines;
-                    std::string current_line = "";
-                    std::string date_str(date_buffer);
-                    std::istringstream words(date_str);
-                    std::string word;
-
-                    while (words >> word) {
-                        std::string test_line = current_line.empty() ? word : current_line + " " + word;
-                        int test_width = DrawText(temp_canvas, font_date, 0, 0, display_color, NULL, test_line.c_str());
-
-                        if (test_width <= MATRIX_WIDTH) {
-                            current_line = test_line;
-                        } else {
-                            if (!current_line.empty()) {
-                                lines.push_back(current_line);
-                            }
-                            current_line = word;
-                        }
-                    }
-                    if (!current_line.empty()) {
-                        lines.push_back(current_line);
-                    }
-
-                    // Calculate total height and center vertically
-                    int date_height = font_date.height();
-                    int total_height = lines.size() * date_height;
-                    int start_y = (MATRIX_HEIGHT - total_height) / 2;
-
-                    // Draw each line centered
-                    for (size_t i = 0; i < lines.size(); i++) {
-                        int line_width = DrawText(temp_canvas, font_date, 0, 0, display_color, NULL, lines[i].c_str());
-                        int line_x = (MATRIX_WIDTH - line_width) / 2;
-                        int line_y = start_y + (i * date_height) + font_date.baseline();
-                        DrawText(offscreen_canvas, font_date, line_x, line_y, display_color, NULL, lines[i].c_str());
-                    }
-                }
-            } else if (!config.showDate && config.showTime) {
-                // Show only time (centered vertically)
-                int time_width = DrawText(temp_canvas, font_time, 0, 0, display_color, NULL, time_buffer);
+            // Get current time (cached UTC offset, no per-frame localtime())
+            const struct tm& tm_now = local_time.now();
 
-                // Center horizontally and vertically
-                int time_x = (MATRIX_WIDTH - time_width) / 2;
-                int time_y = (MATRIX_HEIGHT / 2) + (font_time.baseline() / 2);
+            // Format date (uppercase) and time: only fields whose period
+            // boundary was crossed are re-rendered
+            date_format.update(tm_now);
+            time_format.update(tm_now);
+            date_text = date_format.text();
+            time_text = time_format.text();
+        }
 
-                DrawText(offscreen_canvas, font_time, time_x, time_y, display_color, NULL, time_buffer);
+        // Frame-content key: everything that reaches the pixels (layout and
+        // fonts are fixed at startup). The snake changes every frame it runs.
+        bool snake_active = snakeAnimation.isAnimating();
+        frame_key.reset();
+        frame_key.add(show).add(display_color.r).add(display_color.g).add(display_color.b).add(config.brightness);
+        frame_key.add(message_opacity);
+        if (message_opacity > 0) frame_key.add(message_text.c_str()).add(message_color.r).add(message_color.g).add(message_color.b);
+        if (show == SHOW_CLOCK) frame_key.add(date_text);
+        if (show == SHOW_CLOCK) frame_key.add(time_text);
+        frame_key.add(snake_active);
+        if (snake_active) frame_key.add(current_time);
+
+        if (frame_key.value() == last_frame_key) {
+            // Identical to the frame on screen: nothing to publish. An input
+            // that changed nothing never reaches the photons.
+            frames_elided++;
+            if (!input_published) input_dispatch_us = 0;
+        } else {
+            last_frame_key = frame_key.value();
+
+            // Describe the frame; the render thread draws the newest one
+            FrameState& frame = renderer.next();
+            frame.content = show;
+            frame.color = display_color;
+            frame.date = date_text;
+            frame.time = time_text;
+            frame.label = Locale::MSG_AUTO;
+            frame.message = message_text;
+            frame.message_color = message_color;
+            frame.message_opacity = message_opacity;
+            if (snake_active) {
+                frame.snake = snakeAnimation.update();
+            } else {
+                frame.snake.clear();
             }
-            // If neither is shown (shouldn't happen due to validation), nothing is drawn
+            frame.brightness = config.brightness;
+            frame.input_edge_ms = input_edge_ms;
+            frame.input_dispatch_us = input_dispatch_us;
+            if (input_dispatch_us != 0) input_published = true;
+            renderer.publish();
         }
+        frame_stats.record(FrameStats::UPDATE, monotonicUs() - input_done_us);
 
-        // Draw border snake animation if active (on top of everything)
-        if (snakeAnimation.isAnimating()) {
-            auto snakePixels = snakeAnimation.update();
-            for (const auto& pixel : snakePixels) {
-                const Point& p = pixel.first;
-                const RGBColor& c = pixel.second;
-                offscreen_canvas->SetPixel(p.x, p.y, c.r, c.g, c.b);
-            }
+        // Save the changed config from a snapshot on the writer thread,
+        // after the frame showing the change has been published
+        if (g_config_save_at != 0 && current_time >= g_config_save_at) {
+            g_config_save_at = 0;
+            config_saver.request(config);
         }
 
-        // Swap buffers
-        offscreen_canvas = matrix->SwapOnVSync(offscreen_canvas);
+        if (latency_report_requested) {
+            latency_report_requested = 0;
+            renderer.requestReport();
+            frame_stats.report(stdout);
+            printFrameStats(renderer.framesDrawn(), frames_elided);
+        }
+
+        // Schedule the next frame: sleep until something visible can change
+        if (animator.isAnimating() || snakeAnimation.isAnimating() || polled_input) {
+            scheduler.wakeAt(current_time + FRAME_INTERVAL_MS);
+        }
+        if (message_display_until > current_time) {
+            // Every frame while fading, otherwise at the start of the fade-out
+            long fade_out_at = message_display_until - MESSAGE_FADE_MS;
+            scheduler.wakeAt(message_opacity < 255 ? current_time + FRAME_INTERVAL_MS : fade_out_at);
+            scheduler.wakeAt(message_display_until);
+        }
+        if (g_config_save_at != 0) scheduler.wakeAt(g_config_save_at);
+        bool auto_mode = !(config.fixed_color >= 0 && config.fixed_color < (int)config.colors.size());
+        if (auto_mode && config.colorTransitionEnabled && config.colors.size() >= 2) {
+            // Start of the next transition window, then the color change itself
+            long transition_at = next_color_change_time - config.colorTransitionDurationMs;
+            scheduler.wakeAt(transition_at > current_time ? transition_at : next_color_change_time);
+        }
+        scheduler.wakeOnWallBoundary(wall_period);
 
-        // Update frequency
-        usleep(MAIN_LOOP_USLEEP); // 50ms for responsive button detection
+        scheduler.wait();
+        if (scheduler.lateness() >= 0) frame_stats.record(FrameStats::JITTER, scheduler.lateness());
+        if (scheduler.takeSignal(SIGTERM) || scheduler.takeSignal(SIGINT)) interrupt_received = true;
+        if (scheduler.takeSignal(SIGUSR1)) latency_report_requested = 1;
     }
 
-    // Cleanup
-    matrix->Clear();
-    delete matrix;
+    // Cleanup (a save still waiting for the knob to settle is written now)
+    if (g_config_save_at != 0) config_saver.request(config);
+    shutdown();
+    renderer.report(stdout);
+    frame_stats.report(stdout);
+    printFrameStats(renderer.framesDrawn(), frames_elided);
 
     printf("\nClock stopped.\n");
     return 0;
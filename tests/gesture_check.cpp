@@ -0,0 +1,144 @@
+// Gesture replay vs expected events (make check)
+// Replays each tests/gestures/<name>.sim through SimulatedBackend in
+// virtual-clock mode and a GPIOButton, once stepping to every edge and
+// deadline and once at a coarse polling step, and compares the gestures
+// (type and timestamp, in order) with tests/gestures/<name>.expected.
+
+#include "GPIOButton.h"
+#include "SimulatedBackend.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define GESTURE_DIR "tests/gestures/"       // Scripts and expected events
+#define GESTURE_COARSE_STEP 1000            // Coarse polling step (ms)
+#define GESTURE_TAIL_MS 5000                // Replay time after the last edge (ms)
+
+/** One replayed script and its timing windows */
+struct GestureCase {
+    const char* name;           // tests/gestures/<name>.sim / .expected
+    int multi_tap_ms;           // 0 = multi-tap off
+    int repeat_interval_ms;     // 0 = repeat off
+};
+
+static const GestureCase CASES[] = {
+    { "tap", 0, 0 },
+    { "multi_tap", 300, 0 },
+    { "long_press", 300, 0 },
+    { "repeat", 0, 250 },
+    { "bounce", 300, 0 },
+};
+
+static const char* const EVENT_NAMES[] = {
+    "PRESS", "RELEASE", "TAP", "DOUBLE_TAP", "TRIPLE_TAP", "LONG_PRESS", "HOLD_REPEAT", "HOLD_RELEASE",
+};
+
+// One line per gesture: "<time_ms> <EVENT>"
+static std::string format(const ButtonEvent& event) {
+    char line[64];
+    snprintf(line, sizeof(line), "%ld %s", event.time_ms, EVENT_NAMES[event.type]);
+    return line;
+}
+
+// Expected lines of a case ('#' starts a comment), false if unreadable
+static bool loadExpected(const std::string& path, std::vector<std::string>& lines) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) return false;
+
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), file)) {
+        char* comment = strchr(buffer, '#');
+        if (comment) *comment = '\0';
+        long time_ms;
+        char event[32];
+        if (sscanf(buffer, "%ld %31s", &time_ms, event) != 2) continue;
+        char line[64];
+        snprintf(line, sizeof(line), "%ld %s", time_ms, event);
+        lines.push_back(line);
+    }
+    fclose(file);
+    return true;
+}
+
+// Replay a script; step 0 = jump to every edge and deadline
+static bool replay(const GestureCase& c, long step, std::vector<std::string>& events) {
+    SimulatedBackend* backend = new SimulatedBackend(std::string(GESTURE_DIR) + c.name + ".sim", false);
+    GestureTiming timing;
+    timing.multi_tap_ms = c.multi_tap_ms;
+    timing.repeat_interval_ms = c.repeat_interval_ms;
+    GPIOButton button(backend, timing);
+    if (!button.setup()) return false;
+
+    // The dispatch observer only sees events with a callback
+    std::function<void()> none = []() {};
+    button.onPress(none);
+    button.onRelease(none);
+    button.onTap(none);
+    if (c.multi_tap_ms > 0) {
+        button.onDoubleTap(none);
+        button.onTripleTap(none);
+    }
+    button.onLongPress(none);
+    button.onHoldRepeat(none);
+    button.onHoldRelease(none);
+    button.onDispatch([&events](const ButtonEvent& event) { events.push_back(format(event)); });
+
+    long end = backend->endTime() + GESTURE_TAIL_MS;
+    for (long now = 0; now <= end;) {
+        backend->advanceTo(now);
+        button.process(now);
+        if (step > 0) {
+            now += step;
+            continue;
+        }
+        long next = backend->nextEdgeTime();
+        long deadline = button.nextDeadline();
+        if (deadline >= 0 && (next < 0 || deadline < next)) next = deadline;
+        if (next < 0) break;
+        now = next > now ? next : now + 1;
+    }
+    return true;
+}
+
+// Compare a replay with the expected events, print the first difference
+static bool same(const GestureCase& c, const char* mode, const std::vector<std::string>& actual,
+                 const std::vector<std::string>& expected) {
+    for (size_t i = 0; i < actual.size() || i < expected.size(); i++) {
+        const char* got = i < actual.size() ? actual[i].c_str() : "(end)";
+        const char* want = i < expected.size() ? expected[i].c_str() : "(end)";
+        if (strcmp(got, want) != 0) {
+            printf("❌ %s (%s): event %zu is \"%s\", expected \"%s\"\n", c.name, mode, i + 1, got, want);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    int failed = 0, count = sizeof(CASES) / sizeof(CASES[0]);
+
+    for (int i = 0; i < count; i++) {
+        const GestureCase& c = CASES[i];
+        std::vector<std::string> expected, exact, coarse;
+        if (!loadExpected(std::string(GESTURE_DIR) + c.name + ".expected", expected)) {
+            printf("❌ %s: no %s%s.expected\n", c.name, GESTURE_DIR, c.name);
+            failed++;
+            continue;
+        }
+        if (!replay(c, 0, exact) || !replay(c, GESTURE_COARSE_STEP, coarse)) {
+            printf("❌ %s: couldn't load %s%s.sim\n", c.name, GESTURE_DIR, c.name);
+            failed++;
+            continue;
+        }
+
+        bool ok = same(c, "every deadline", exact, expected);
+        ok = same(c, "coarse polling", coarse, expected) && ok;
+        if (ok) printf("✓ %-12s %zu events\n", c.name, expected.size());
+        if (!ok) failed++;
+    }
+
+    printf("%s Gesture check: %d scripts, %d failed\n", failed == 0 ? "✓" : "❌", count, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// LocalTime vs localtime_r() over a year (make check)
+// For each zone: every 61 s of CHECK_YEAR, plus every second within an
+// hour of each UTC offset change, must give the same broken-down time,
+// DST flag, offset and abbreviation as localtime_r(). Zones not installed
+// on the machine are skipped; zones where LocalTime falls back to
+// localtime_r() (leap seconds) are reported but not compared.
+
+#include "LocalTime.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <unistd.h>
+
+#define CHECK_START 1735689600              // 2025-01-01 00:00:00 UTC
+#define CHECK_END 1767225600                // 2026-01-01 00:00:00 UTC
+#define CHECK_STEP 61                       // Coarse step (s, prime to the minute)
+#define CHECK_WINDOW 3600                   // Exhaustive window around each offset change (s)
+
+// Zones with DST in either hemisphere, half-hour and 45-minute offsets,
+// a 30-minute DST shift, no DST, leap seconds and a POSIX rule
+static const char* const ZONES[] = {
+    "Europe/Rome", "America/New_York", "Australia/Lord_Howe", "Asia/Kolkata", "America/Santiago",
+    "Pacific/Chatham", "UTC", "right/Europe/Rome", "CET-1CEST,M3.5.0,M10.5.0/3",
+};
+
+// Compare one instant; print the first mismatches of a zone
+static bool same(LocalTime& local_time, time_t t, const char* zone, unsigned long& mismatches) {
+    struct tm expected;
+    localtime_r(&t, &expected);
+    const struct tm& actual = local_time.at(t);
+    if (actual.tm_sec == expected.tm_sec && actual.tm_min == expected.tm_min && actual.tm_hour == expected.tm_hour &&
+        actual.tm_mday == expected.tm_mday && actual.tm_mon == expected.tm_mon && actual.tm_year == expected.tm_year &&
+        actual.tm_wday == expected.tm_wday && actual.tm_yday == expected.tm_yday &&
+        actual.tm_isdst == expected.tm_isdst && actual.tm_gmtoff == expected.tm_gmtoff &&
+        strcmp(actual.tm_zone, expected.tm_zone ? expected.tm_zone : "") == 0) {
+        return true;
+    }
+    if (mismatches++ < 5) {
+        printf("❌ %s at %lld: %04d-%02d-%02d %02d:%02d:%02d %s, expected %04d-%02d-%02d %02d:%02d:%02d %s\n",
+               zone, static_cast<long long>(t),
+               actual.tm_year + 1900, actual.tm_mon + 1, actual.tm_mday, actual.tm_hour, actual.tm_min, actual.tm_sec,
+               actual.tm_zone, expected.tm_year + 1900, expected.tm_mon + 1, expected.tm_mday,
+               expected.tm_hour, expected.tm_min, expected.tm_sec, expected.tm_zone ? expected.tm_zone : "");
+    }
+    return false;
+}
+
+int main() {
+    unsigned long total = 0, failed = 0;
+    int zones = 0, fallbacks = 0;
+
+    for (size_t z = 0; z < sizeof(ZONES) / sizeof(ZONES[0]); z++) {
+        const char* zone = ZONES[z];
+        bool rule = strchr(zone, ',') != NULL;
+        if (!rule && access((std::string("/usr/share/zoneinfo/") + zone).c_str(), R_OK) != 0) {
+            printf("⚠ %s not installed, skipped\n", zone);
+            continue;
+        }
+        setenv("TZ", zone, 1);
+        tzset();
+
+        // A fallback zone would only compare localtime_r() with itself
+        LocalTime local_time;
+        local_time.at(CHECK_START);
+        if (!local_time.exact()) {
+            printf("⚠ %-28s falls back to localtime_r(), not compared\n", zone);
+            fallbacks++;
+            continue;
+        }
+
+        unsigned long checked = 0, mismatches = 0;
+        int changes = 0;
+        struct tm previous;
+        time_t prev_t = CHECK_START;
+        localtime_r(&prev_t, &previous);
+        for (time_t t = CHECK_START; t < CHECK_END; t += CHECK_STEP) {
+            same(local_time, t, zone, mismatches);
+            checked++;
+
+            // Offset changed within the last step: every second around it
+            struct tm current;
+            localtime_r(&t, &current);
+            if (current.tm_gmtoff != previous.tm_gmtoff || current.tm_isdst != previous.tm_isdst) {
+                for (time_t u = prev_t - CHECK_WINDOW; u <= t + CHECK_WINDOW; u++) {
+                    same(local_time, u, zone, mismatches);
+                    checked++;
+                }
+                changes++;
+            }
+            previous = current;
+            prev_t = t;
+        }
+
+        printf("%s %-28s %9lu instants, %d offset changes, %lu reloads, %lu mismatches\n",
+               mismatches == 0 ? "✓" : "❌", zone, checked, changes, local_time.reloads(), mismatches);
+        total += checked;
+        if (mismatches > 0) failed++;
+        zones++;
+    }
+
+    printf("🕒 LocalTime check: %d zones compared (%d fallback), %lu instants, %lu zones failed\n",
+           zones, fallbacks, total, failed);
+    return failed == 0 ? 0 : 1;
+}
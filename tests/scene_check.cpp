@@ -0,0 +1,135 @@
+// Scene damage tracking vs full redraw (make check)
+// Drives two identical scenes through SCENE_CHECK_FRAMES frames of mixed
+// content (ticking clock, relayouts, color changes, AUTO label, message
+// box, border snake): one recomposes only its damage into a persistent
+// framebuffer and draws the time from the digit sprites, the other is
+// invalidated and redrawn in full from plain text every frame. Every frame
+// must be pixel-identical.
+
+#include "BitmapFont.h"
+#include "Config.h"
+#include "FrameBuffer.h"
+#include "LayoutEngine.h"
+#include "Scene.h"
+#include "TextMeasurer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define SCENE_CHECK_FRAMES 20000            // Frames compared
+#define SCENE_CHECK_SEED 12345u             // Content generator seed
+
+// Deterministic pseudo-random numbers (xorshift32)
+static uint32_t g_state = SCENE_CHECK_SEED;
+static uint32_t nextRandom(uint32_t range) {
+    g_state ^= g_state << 13;
+    g_state ^= g_state >> 17;
+    g_state ^= g_state << 5;
+    return g_state % range;
+}
+
+// Load a bundled font (FONT_DIR), exit on failure
+static void loadFont(BitmapFont& font, const char* name) {
+    std::string path = std::string(FONT_DIR) + name;
+    if (!font.load(path.c_str())) {
+        fprintf(stderr, "Couldn't load %s\n", path.c_str());
+        exit(1);
+    }
+}
+
+/** The nodes of one scene (owned by the scene) */
+struct Nodes {
+    LayoutNode* text;       // Clock or AUTO label
+    RectNode* box;          // Message background
+    TextNode* message;      // Message text
+    PathNode* snake;        // Border snake
+};
+
+// Build the node tree of a scene
+static Nodes buildScene(Scene& scene) {
+    Nodes nodes;
+    nodes.text = static_cast<LayoutNode*>(scene.root().add(new LayoutNode()));
+    nodes.box = static_cast<RectNode*>(scene.root().add(new RectNode()));
+    nodes.message = static_cast<TextNode*>(scene.root().add(new TextNode()));
+    nodes.snake = static_cast<PathNode*>(scene.root().add(new PathNode()));
+    return nodes;
+}
+
+int main() {
+    BitmapFont font_date, font_time;
+    loadFont(font_date, "5x8.bdf");
+    loadFont(font_time, "7x14B.bdf");
+
+    TextMeasurer measurer;
+    Config config;
+    LayoutEngine layout_engine(config, font_date, font_time, measurer, 64, 32);
+
+    Scene incremental(64, 32), reference(64, 32);
+    Nodes a = buildScene(incremental), b = buildScene(reference);
+    FrameBuffer fb_incremental(64, 32), fb_reference(64, 32);
+
+    static const char* const dates[] = { "TUE 31 DEC", "WED 1 JAN", "MON 10 FEB" };
+    static const char* const messages[] = { "50%", "100%", "RED", "AUTO" };
+    const RGBColor colors[] = { RGBColor(255, 128, 0), RGBColor(0, 255, 64), RGBColor(200, 200, 255) };
+
+    int seconds = 12 * 3600 + 34 * 60, date = 0, color = 0, message = -1, snake_head = -1;
+    bool show_auto = false;
+    unsigned long mismatches = 0, redrawn = 0;
+    std::vector<std::pair<Point, RGBColor> > snake;
+
+    for (int frame = 0; frame < SCENE_CHECK_FRAMES; frame++) {
+        // Mostly clock ticks, sometimes a bigger change
+        seconds = (seconds + 1 + (nextRandom(50) == 0 ? nextRandom(40000) : 0)) % 86400;
+        if (nextRandom(300) == 0) date = nextRandom(3);
+        if (nextRandom(200) == 0) color = nextRandom(3);
+        if (nextRandom(400) == 0) show_auto = !show_auto;
+        if (nextRandom(100) == 0) message = message < 0 ? static_cast<int>(nextRandom(4)) : -1;
+        if (nextRandom(150) == 0) snake_head = snake_head < 0 ? 0 : -1;
+
+        char time_text[16];
+        snprintf(time_text, sizeof(time_text), "%02d:%02d:%02d", seconds / 3600, seconds / 60 % 60, seconds % 60);
+        const Layout& layout = show_auto ? layout_engine.centered(font_time, "AUTO", 20)
+                                         : layout_engine.clock(dates[date], time_text);
+
+        // Snake: 12 pixels running along the border
+        snake.clear();
+        if (snake_head >= 0) {
+            for (int i = 0; i < 12; i++) {
+                int p = (snake_head + i) % 188;
+                int x = p < 64 ? p : (p < 94 ? 63 : (p < 158 ? 63 - (p - 94) : 0));
+                int y = p < 64 ? 0 : (p < 94 ? p - 63 : (p < 158 ? 31 : 31 - (p - 158)));
+                snake.push_back(std::make_pair(Point(x, y), RGBColor(255, static_cast<uint8_t>(i * 20), 0)));
+            }
+            snake_head = (snake_head + 1) % 188;
+        }
+
+        Nodes* both[] = { &a, &b };
+        for (int s = 0; s < 2; s++) {
+            Nodes& n = *both[s];
+            // Only the incremental scene draws the time from the digit sprites
+            n.text->set(layout, colors[color], s == 0 && !show_auto ? layout_engine.timeRun() : -1);
+            n.box->set(8, 10, 48, 12, RGBColor());
+            n.box->setVisible(message >= 0);
+            n.message->set(font_date, 12, 19, RGBColor(255, 255, 255), message >= 0 ? messages[message] : "");
+            n.message->setVisible(message >= 0);
+            n.snake->set(snake);
+        }
+
+        if (incremental.compose(fb_incremental)) redrawn++;
+        reference.invalidate();
+        fb_reference.clear();
+        reference.compose(fb_reference);
+
+        if (memcmp(fb_incremental.pixels(), fb_reference.pixels(), 64 * 32 * 3) != 0) {
+            if (mismatches++ < 5) printf("❌ Frame %d (%s) differs from a full redraw\n", frame, time_text);
+        }
+    }
+
+    printf("%s Scene check: %d frames (%lu recomposed), %lu differ from a full redraw\n",
+           mismatches == 0 ? "✓" : "❌", SCENE_CHECK_FRAMES, redrawn, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}